@@ -11976,6 +11976,72 @@ static void test_scissor(void)
     release_test_context(&test_context);
 }
 
+static void test_draw_throughput(void)
+{
+    struct d3d11_test_context test_context;
+    ID3D11DeviceContext *immediate_context;
+    LARGE_INTEGER frequency, start, end;
+    ID3D11BlendState *blend_states[2];
+    D3D11_BLEND_DESC blend_desc;
+    ID3D11Device *device;
+    unsigned int i;
+    HRESULT hr;
+
+    static const float red[] = {1.0f, 0.0f, 0.0f, 1.0f};
+    static const struct vec4 green = {0.0f, 1.0f, 0.0f, 1.0f};
+    static const unsigned int draw_count = 100000;
+
+    if (!winetest_interactive)
+    {
+        skip("Skipping the draw throughput benchmark.\n");
+        return;
+    }
+
+    if (!init_test_context(&test_context, NULL))
+        return;
+
+    device = test_context.device;
+    immediate_context = test_context.immediate_context;
+
+    /* Alternate between two blend states that both leave the output
+     * unchanged, so that every draw needs a different pipeline. */
+    memset(&blend_desc, 0, sizeof(blend_desc));
+    blend_desc.RenderTarget[0].BlendEnable = FALSE;
+    blend_desc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+    hr = ID3D11Device_CreateBlendState(device, &blend_desc, &blend_states[0]);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+    blend_desc.RenderTarget[0].BlendEnable = TRUE;
+    blend_desc.RenderTarget[0].SrcBlend = D3D11_BLEND_ONE;
+    blend_desc.RenderTarget[0].DestBlend = D3D11_BLEND_ZERO;
+    blend_desc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+    blend_desc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
+    blend_desc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
+    blend_desc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
+    hr = ID3D11Device_CreateBlendState(device, &blend_desc, &blend_states[1]);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+
+    ID3D11DeviceContext_ClearRenderTargetView(immediate_context, test_context.backbuffer_rtv, red);
+    draw_color_quad(&test_context, &green);
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&start);
+    for (i = 0; i < draw_count; ++i)
+    {
+        ID3D11DeviceContext_OMSetBlendState(immediate_context, blend_states[i & 1], NULL, D3D11_DEFAULT_SAMPLE_MASK);
+        ID3D11DeviceContext_Draw(immediate_context, 4, 0);
+    }
+    check_texture_color(test_context.backbuffer, 0xff00ff00, 1);
+    QueryPerformanceCounter(&end);
+
+    trace("%u draws in %.3f ms, %.0f draws/s.\n", draw_count,
+            (end.QuadPart - start.QuadPart) * 1000.0 / frequency.QuadPart,
+            draw_count * (double)frequency.QuadPart / (end.QuadPart - start.QuadPart));
+
+    ID3D11BlendState_Release(blend_states[0]);
+    ID3D11BlendState_Release(blend_states[1]);
+    release_test_context(&test_context);
+}
+
 static void test_clear_state(void)
 {
     static const D3D_FEATURE_LEVEL feature_level = D3D_FEATURE_LEVEL_11_0;
@@ -35528,6 +35594,7 @@ START_TEST(d3d11)
     queue_test(test_render_target_views);
     queue_test(test_layered_rendering);
     queue_test(test_scissor);
+    queue_test(test_draw_throughput);
     queue_test(test_clear_state);
     queue_test(test_il_append_aligned);
     queue_test(test_vertex_id);
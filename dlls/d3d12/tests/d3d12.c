@@ -215,14 +215,9 @@ static ID3D12RootSignature *create_default_root_signature(ID3D12Device *device)
     return root_signature;
 }
 
-#define create_pipeline_state(a, b, c, d) create_pipeline_state_(__LINE__, a, b, c, d)
-static ID3D12PipelineState *create_pipeline_state_(unsigned int line, ID3D12Device *device,
+static void init_pipeline_state_desc(D3D12_GRAPHICS_PIPELINE_STATE_DESC *pipeline_state_desc,
         ID3D12RootSignature *root_signature, DXGI_FORMAT rt_format, const D3D12_SHADER_BYTECODE *ps)
 {
-    D3D12_GRAPHICS_PIPELINE_STATE_DESC pipeline_state_desc;
-    ID3D12PipelineState *pipeline_state;
-    HRESULT hr;
-
     static const DWORD vs_code[] =
     {
 #if 0
@@ -268,18 +263,29 @@ static ID3D12PipelineState *create_pipeline_state_(unsigned int line, ID3D12Devi
     if (!ps)
         ps = &default_ps;
 
-    memset(&pipeline_state_desc, 0, sizeof(pipeline_state_desc));
-    pipeline_state_desc.pRootSignature = root_signature;
-    pipeline_state_desc.VS = vs;
-    pipeline_state_desc.PS = *ps;
-    pipeline_state_desc.BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
-    pipeline_state_desc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
-    pipeline_state_desc.RasterizerState.CullMode = D3D12_CULL_MODE_BACK;
-    pipeline_state_desc.SampleMask = ~(UINT)0;
-    pipeline_state_desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
-    pipeline_state_desc.NumRenderTargets = 1;
-    pipeline_state_desc.RTVFormats[0] = rt_format;
-    pipeline_state_desc.SampleDesc.Count = 1;
+    memset(pipeline_state_desc, 0, sizeof(*pipeline_state_desc));
+    pipeline_state_desc->pRootSignature = root_signature;
+    pipeline_state_desc->VS = vs;
+    pipeline_state_desc->PS = *ps;
+    pipeline_state_desc->BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+    pipeline_state_desc->RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+    pipeline_state_desc->RasterizerState.CullMode = D3D12_CULL_MODE_BACK;
+    pipeline_state_desc->SampleMask = ~(UINT)0;
+    pipeline_state_desc->PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+    pipeline_state_desc->NumRenderTargets = 1;
+    pipeline_state_desc->RTVFormats[0] = rt_format;
+    pipeline_state_desc->SampleDesc.Count = 1;
+}
+
+#define create_pipeline_state(a, b, c, d) create_pipeline_state_(__LINE__, a, b, c, d)
+static ID3D12PipelineState *create_pipeline_state_(unsigned int line, ID3D12Device *device,
+        ID3D12RootSignature *root_signature, DXGI_FORMAT rt_format, const D3D12_SHADER_BYTECODE *ps)
+{
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC pipeline_state_desc;
+    ID3D12PipelineState *pipeline_state;
+    HRESULT hr;
+
+    init_pipeline_state_desc(&pipeline_state_desc, root_signature, rt_format, ps);
     hr = ID3D12Device_CreateGraphicsPipelineState(device, &pipeline_state_desc,
             &IID_ID3D12PipelineState, (void **)&pipeline_state);
     ok_(__FILE__, line)(hr == S_OK, "Failed to create graphics pipeline state, hr %#lx.\n", hr);
@@ -1497,6 +1503,96 @@ static void test_invalid_command_queue_types(void)
     ok(!refcount, "Device has %lu references left.\n", refcount);
 }
 
+static void test_pipeline_library(void)
+{
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC pipeline_state_desc;
+    ID3D12PipelineState *pipeline_state, *pipeline_state2;
+    ID3D12RootSignature *root_signature;
+    ID3D12PipelineLibrary *library;
+    ID3D12Device1 *device1;
+    ID3D12Device *device;
+    SIZE_T size, size2;
+    ULONG refcount;
+    void *data;
+    HRESULT hr;
+
+    if (!(device = create_device()))
+    {
+        skip("Failed to create Direct3D 12 device.\n");
+        return;
+    }
+
+    if (FAILED(ID3D12Device_QueryInterface(device, &IID_ID3D12Device1, (void **)&device1)))
+    {
+        skip("ID3D12Device1 is not available.\n");
+        ID3D12Device_Release(device);
+        return;
+    }
+
+    hr = ID3D12Device1_CreatePipelineLibrary(device1, NULL, 0, &IID_ID3D12PipelineLibrary, (void **)&library);
+    if (hr == DXGI_ERROR_UNSUPPORTED)
+    {
+        skip("Pipeline libraries are not supported.\n");
+        ID3D12Device1_Release(device1);
+        ID3D12Device_Release(device);
+        return;
+    }
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+
+    root_signature = create_default_root_signature(device);
+    init_pipeline_state_desc(&pipeline_state_desc, root_signature, DXGI_FORMAT_R8G8B8A8_UNORM, NULL);
+    hr = ID3D12Device_CreateGraphicsPipelineState(device, &pipeline_state_desc,
+            &IID_ID3D12PipelineState, (void **)&pipeline_state);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+
+    hr = ID3D12PipelineLibrary_StorePipeline(library, L"green", pipeline_state);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+    hr = ID3D12PipelineLibrary_StorePipeline(library, L"green", pipeline_state);
+    ok(hr == E_INVALIDARG, "Got unexpected hr %#lx.\n", hr);
+
+    hr = ID3D12PipelineLibrary_LoadGraphicsPipeline(library, L"red", &pipeline_state_desc,
+            &IID_ID3D12PipelineState, (void **)&pipeline_state2);
+    ok(hr == E_INVALIDARG, "Got unexpected hr %#lx.\n", hr);
+    hr = ID3D12PipelineLibrary_LoadGraphicsPipeline(library, L"green", &pipeline_state_desc,
+            &IID_ID3D12PipelineState, (void **)&pipeline_state2);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+    ID3D12PipelineState_Release(pipeline_state2);
+
+    pipeline_state_desc.RTVFormats[0] = DXGI_FORMAT_B8G8R8A8_UNORM;
+    hr = ID3D12PipelineLibrary_LoadGraphicsPipeline(library, L"green", &pipeline_state_desc,
+            &IID_ID3D12PipelineState, (void **)&pipeline_state2);
+    ok(hr == E_INVALIDARG, "Got unexpected hr %#lx.\n", hr);
+    pipeline_state_desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
+
+    size = ID3D12PipelineLibrary_GetSerializedSize(library);
+    ok(size, "Got unexpected size %Iu.\n", size);
+    data = malloc(size);
+    hr = ID3D12PipelineLibrary_Serialize(library, data, size);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+    refcount = ID3D12PipelineLibrary_Release(library);
+    ok(!refcount, "Pipeline library has %lu references left.\n", refcount);
+
+    hr = ID3D12Device1_CreatePipelineLibrary(device1, data, size, &IID_ID3D12PipelineLibrary, (void **)&library);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+    size2 = ID3D12PipelineLibrary_GetSerializedSize(library);
+    ok(size2 >= size, "Got unexpected size %Iu, expected at least %Iu.\n", size2, size);
+    hr = ID3D12PipelineLibrary_LoadGraphicsPipeline(library, L"green", &pipeline_state_desc,
+            &IID_ID3D12PipelineState, (void **)&pipeline_state2);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+    ID3D12PipelineState_Release(pipeline_state2);
+    hr = ID3D12PipelineLibrary_StorePipeline(library, L"green", pipeline_state);
+    ok(hr == E_INVALIDARG, "Got unexpected hr %#lx.\n", hr);
+    refcount = ID3D12PipelineLibrary_Release(library);
+    ok(!refcount, "Pipeline library has %lu references left.\n", refcount);
+    free(data);
+
+    ID3D12PipelineState_Release(pipeline_state);
+    ID3D12RootSignature_Release(root_signature);
+    ID3D12Device1_Release(device1);
+    refcount = ID3D12Device_Release(device);
+    ok(!refcount, "Device has %lu references left.\n", refcount);
+}
+
 START_TEST(d3d12)
 {
     BOOL enable_debug_layer = FALSE;
@@ -1533,4 +1629,5 @@ START_TEST(d3d12)
     test_swapchain_backbuffer_index();
     test_desktop_window();
     test_invalid_command_queue_types();
+    test_pipeline_library();
 }
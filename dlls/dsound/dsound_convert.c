@@ -37,6 +37,9 @@
 
 #include <stdarg.h>
 #include <math.h>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 
 #include "windef.h"
 #include "winbase.h"
@@ -324,6 +327,10 @@ void put_quad2stereo(const IDirectSoundBufferImpl *dsb, DWORD pos, DWORD channel
 void mixieee32(float *src, float *dst, unsigned samples)
 {
     TRACE("%p - %p %d\n", src, dst, samples);
+#ifdef __SSE__
+    for (; samples >= 4; samples -= 4, src += 4, dst += 4)
+        _mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_loadu_ps(src)));
+#endif
     while (samples--)
         *(dst++) += *(src++);
 }
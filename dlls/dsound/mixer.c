@@ -25,6 +25,9 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <math.h>	/* Insomnia - pow() function */
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 
 #define COBJMACROS
 
@@ -314,6 +317,29 @@ static UINT cp_fields_noresample(IDirectSoundBufferImpl *dsb, UINT count)
     return count;
 }
 
+static inline float fir_dot_product(const float *fir, const float *input, int count)
+{
+    float sum = 0.0f;
+    int j = 0;
+
+#ifdef __SSE__
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    float partial[4];
+
+    for (; j + 8 <= count; j += 8)
+    {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(fir + j), _mm_loadu_ps(input + j)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(fir + j + 4), _mm_loadu_ps(input + j + 4)));
+    }
+    _mm_storeu_ps(partial, _mm_add_ps(acc0, acc1));
+    sum = (partial[0] + partial[1]) + (partial[2] + partial[3]);
+#endif
+
+    for (; j < count; j++)
+        sum += fir[j] * input[j];
+    return sum;
+}
+
 static UINT cp_fields_resample(IDirectSoundBufferImpl *dsb, UINT count, LONG64 *freqAccNum)
 {
     UINT i, channel;
@@ -388,11 +414,8 @@ static UINT cp_fields_resample(IDirectSoundBufferImpl *dsb, UINT count, LONG64 *
         assert(ipos + fir_used <= required_input);
 
         for (channel = 0; channel < dsb->mix_channels; channel++) {
-            int j;
-            float sum = 0.0;
             float* cache = &intermediate[channel * required_input + ipos];
-            for (j = 0; j < fir_used; j++)
-                sum += fir_copy[j] * cache[j];
+            float sum = fir_dot_product(fir_copy, cache, fir_used);
             dsb->put(dsb, i * ostride, channel, sum * dsb->firgain);
         }
     }
@@ -509,7 +532,28 @@ static void DSOUND_MixerVol(const IDirectSoundBufferImpl *dsb, INT frames)
 	for (i = 0; i < channels; ++i)
 		vols[i] = dsb->volpan.dwTotalAmpFactor[i] / ((float)0xFFFF);
 
-	for(i = 0; i < frames; ++i){
+	i = 0;
+#ifdef __SSE__
+	{
+		/* Four frames hold a whole number of four-float vectors whatever
+		 * the channel count, so precompute the repeating volume pattern. */
+		float *buffer = dsb->device->tmp_buffer;
+		__m128 pattern[DS_MAX_CHANNELS];
+		float tmp[4 * DS_MAX_CHANNELS];
+		UINT j;
+
+		for (j = 0; j < 4 * channels; ++j)
+			tmp[j] = vols[j % channels];
+		for (j = 0; j < channels; ++j)
+			pattern[j] = _mm_loadu_ps(tmp + 4 * j);
+
+		for (; i + 4 <= frames; i += 4, buffer += 4 * channels)
+			for (j = 0; j < channels; ++j)
+				_mm_storeu_ps(buffer + 4 * j, _mm_mul_ps(_mm_loadu_ps(buffer + 4 * j), pattern[j]));
+	}
+#endif
+
+	for(; i < frames; ++i){
 		for(chan = 0; chan < channels; ++chan){
 			dsb->device->tmp_buffer[i * channels + chan] *= vols[chan];
 		}
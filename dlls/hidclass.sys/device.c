@@ -216,17 +216,17 @@ static struct hid_report *hid_queue_pop_report( struct hid_queue *queue )
     return report;
 }
 
-static void hid_device_queue_input( DEVICE_OBJECT *device, HID_XFER_PACKET *packet )
+static void hid_device_queue_input( DEVICE_OBJECT *device, HID_XFER_PACKET *packet, RAWINPUT *rawinput,
+                                    struct hid_report **cached_report )
 {
     BASE_DEVICE_EXTENSION *ext = device->DeviceExtension;
     HIDP_COLLECTION_DESC *desc = ext->u.pdo.device_desc.CollectionDesc;
     const BOOL polled = ext->u.pdo.information.Polled;
     ULONG size, report_len = polled ? packet->reportBufferLen : desc->InputLength;
-    struct hid_report *last_report, *report;
+    struct hid_report *last_report = *cached_report, *report;
     BOOL steam_overlay_open = FALSE;
     struct hid_queue *queue;
     LIST_ENTRY completed, *entry;
-    RAWINPUT *rawinput;
     KIRQL irql;
     IRP *irp;
 
@@ -239,7 +239,7 @@ static void hid_device_queue_input( DEVICE_OBJECT *device, HID_XFER_PACKET *pack
     if (IsEqualGUID( ext->class_guid, &GUID_DEVINTERFACE_HID ) && !steam_overlay_open)
     {
         size = offsetof( RAWINPUT, data.hid.bRawData[report_len] );
-        if (!(rawinput = malloc( size ))) ERR( "Failed to allocate rawinput data!\n" );
+        if (!rawinput) ERR( "Failed to allocate rawinput data!\n" );
         else
         {
             INPUT input;
@@ -258,15 +258,23 @@ static void hid_device_queue_input( DEVICE_OBJECT *device, HID_XFER_PACKET *pack
             input.hi.wParamH = 0;
             input.hi.wParamL = 0;
             __wine_send_input( 0, &input, rawinput );
-
-            free( rawinput );
         }
     }
 
-    if (!(last_report = hid_report_create( packet, report_len )))
+    /* reuse the previous report if no reader queue is still referencing it */
+    if (last_report && last_report->ref == 1 && last_report->length == report_len)
+    {
+        memcpy( last_report->buffer, packet->reportBuffer, packet->reportBufferLen );
+        memset( last_report->buffer + packet->reportBufferLen, 0, report_len - packet->reportBufferLen );
+    }
+    else
     {
-        ERR( "Failed to allocate hid_report!\n" );
-        return;
+        hid_report_decref( last_report );
+        if (!(last_report = *cached_report = hid_report_create( packet, report_len )))
+        {
+            ERR( "Failed to allocate hid_report!\n" );
+            return;
+        }
     }
 
     InitializeListHead( &completed );
@@ -297,8 +305,6 @@ static void hid_device_queue_input( DEVICE_OBJECT *device, HID_XFER_PACKET *pack
         irp = CONTAINING_RECORD( entry, IRP, Tail.Overlay.ListEntry );
         IoCompleteRequest( irp, IO_NO_INCREMENT );
     }
-
-    hid_report_decref( last_report );
 }
 
 static HIDP_REPORT_IDS *find_report_with_type_and_id( BASE_DEVICE_EXTENSION *ext, BYTE type, BYTE id, BOOL any_id )
@@ -323,15 +329,18 @@ static DWORD CALLBACK hid_device_thread(void *args)
     BASE_DEVICE_EXTENSION *ext = device->DeviceExtension;
     HIDP_COLLECTION_DESC *desc = ext->u.pdo.device_desc.CollectionDesc;
     BOOL polled = ext->u.pdo.information.Polled;
+    struct hid_report *cached_report = NULL;
     HIDP_REPORT_IDS *report;
     HID_XFER_PACKET *packet;
     ULONG report_id = 0;
     IO_STATUS_BLOCK io;
+    RAWINPUT *rawinput;
     BYTE *buffer;
     DWORD res;
 
     packet = malloc( sizeof(*packet) + desc->InputLength );
     buffer = (BYTE *)(packet + 1);
+    rawinput = malloc( offsetof( RAWINPUT, data.hid.bRawData[desc->InputLength] ) );
 
     report = find_report_with_type_and_id( ext, HidP_Input, 0, TRUE );
     if (!report) WARN("no input report found.\n");
@@ -364,13 +373,17 @@ static DWORD CALLBACK hid_device_thread(void *args)
                 packet->reportId = buffer[0];
                 packet->reportBuffer = buffer;
                 packet->reportBufferLen = io.Information;
-                hid_device_queue_input( device, packet );
+                hid_device_queue_input( device, packet, rawinput, &cached_report );
             }
         }
 
         res = WaitForSingleObject(ext->u.pdo.halt_event, polled ? ext->u.pdo.poll_interval : 0);
     } while (res == WAIT_TIMEOUT);
 
+    hid_report_decref( cached_report );
+    free( rawinput );
+    free( packet );
+
     TRACE( "device thread exiting, res %#lx\n", res );
     return 1;
 }
@@ -6727,6 +6727,46 @@ static void test_wmv_decoder_media_object(void)
     winetest_pop_context();
 }
 
+/* Repack an NV12 frame into I420, YV12 or YUY2, keeping the same samples. */
+static void convert_nv12_frame(const GUID *subtype, const BYTE *src, BYTE *dst, UINT width, UINT height)
+{
+    const BYTE *src_uv = src + width * height;
+    UINT x, y;
+
+    if (IsEqualGUID(subtype, &MFVideoFormat_YUY2))
+    {
+        for (y = 0; y < height; y++)
+        {
+            const BYTE *uv = src_uv + (y / 2) * width;
+
+            for (x = 0; x < width; x += 2)
+            {
+                dst[(y * width + x) * 2 + 0] = src[y * width + x];
+                dst[(y * width + x) * 2 + 1] = uv[x];
+                dst[(y * width + x) * 2 + 2] = src[y * width + x + 1];
+                dst[(y * width + x) * 2 + 3] = uv[x + 1];
+            }
+        }
+    }
+    else
+    {
+        BYTE *u = dst + width * height, *v = u + width * height / 4;
+
+        if (IsEqualGUID(subtype, &MFVideoFormat_YV12))
+        {
+            v = u;
+            u = v + width * height / 4;
+        }
+
+        memcpy(dst, src, width * height);
+        for (x = 0; x < width * height / 4; x++)
+        {
+            u[x] = src_uv[x * 2];
+            v[x] = src_uv[x * 2 + 1];
+        }
+    }
+}
+
 static void test_color_convert(void)
 {
     const GUID *const class_id = &CLSID_CColorConvertDMO;
@@ -6907,6 +6947,30 @@ static void test_color_convert(void)
         ATTR_UINT32(MF_MT_DEFAULT_STRIDE, actual_width * 4),
         {0},
     };
+    const struct attribute_desc input_type_desc_i420[] =
+    {
+        ATTR_GUID(MF_MT_MAJOR_TYPE, MFMediaType_Video, .required = TRUE),
+        ATTR_GUID(MF_MT_SUBTYPE, MFVideoFormat_I420, .required = TRUE),
+        ATTR_RATIO(MF_MT_FRAME_SIZE, actual_width, actual_height, .required = TRUE),
+        ATTR_BLOB(MF_MT_MINIMUM_DISPLAY_APERTURE, &actual_aperture, 16),
+        {0},
+    };
+    const struct attribute_desc input_type_desc_yv12[] =
+    {
+        ATTR_GUID(MF_MT_MAJOR_TYPE, MFMediaType_Video, .required = TRUE),
+        ATTR_GUID(MF_MT_SUBTYPE, MFVideoFormat_YV12, .required = TRUE),
+        ATTR_RATIO(MF_MT_FRAME_SIZE, actual_width, actual_height, .required = TRUE),
+        ATTR_BLOB(MF_MT_MINIMUM_DISPLAY_APERTURE, &actual_aperture, 16),
+        {0},
+    };
+    const struct attribute_desc input_type_desc_yuy2[] =
+    {
+        ATTR_GUID(MF_MT_MAJOR_TYPE, MFMediaType_Video, .required = TRUE),
+        ATTR_GUID(MF_MT_SUBTYPE, MFVideoFormat_YUY2, .required = TRUE),
+        ATTR_RATIO(MF_MT_FRAME_SIZE, actual_width, actual_height, .required = TRUE),
+        ATTR_BLOB(MF_MT_MINIMUM_DISPLAY_APERTURE, &actual_aperture, 16),
+        {0},
+    };
     const struct attribute_desc expect_input_type_desc[] =
     {
         ATTR_GUID(MF_MT_MAJOR_TYPE, MFMediaType_Video),
@@ -7006,6 +7070,21 @@ static void test_color_convert(void)
         },
 
     };
+    const struct
+    {
+        const char *name;
+        const struct attribute_desc *input_type_desc;
+        const GUID *subtype;
+        DWORD sample_size;
+        ULONG delta;
+    }
+    yuv_input_tests[] =
+    {
+        {"I420", input_type_desc_i420, &MFVideoFormat_I420, actual_width * actual_height * 3 / 2, 4},
+        {"YV12", input_type_desc_yv12, &MFVideoFormat_YV12, actual_width * actual_height * 3 / 2, 4},
+        /* YUY2 has twice the vertical chroma resolution, with the same samples on both lines */
+        {"YUY2", input_type_desc_yuy2, &MFVideoFormat_YUY2, actual_width * actual_height * 2, 6},
+    };
 
     MFT_REGISTER_TYPE_INFO output_type = {MFMediaType_Video, MFVideoFormat_NV12};
     MFT_REGISTER_TYPE_INFO input_type = {MFMediaType_Video, MFVideoFormat_I420};
@@ -7016,6 +7095,7 @@ static void test_color_convert(void)
     ULONG nv12frame_data_len;
     IMFMediaType *media_type;
     IMFTransform *transform;
+    BYTE yuv_data[96 * 96 * 2];
     ULONG i, ret, ref;
     HRESULT hr;
 
@@ -7138,6 +7218,50 @@ static void test_color_convert(void)
         winetest_pop_context();
     }
 
+    for (i = 0; i < ARRAY_SIZE(yuv_input_tests); i++)
+    {
+        winetest_push_context("%s input", yuv_input_tests[i].name);
+        check_mft_set_input_type(transform, yuv_input_tests[i].input_type_desc);
+        check_mft_set_output_type(transform, output_type_desc, S_OK);
+
+        load_resource(L"nv12frame.bmp", &nv12frame_data, &nv12frame_data_len);
+        /* skip BMP header and RGB data from the dump */
+        length = *(DWORD *)(nv12frame_data + 2);
+        nv12frame_data_len = nv12frame_data_len - length;
+        nv12frame_data = nv12frame_data + length;
+        ok(nv12frame_data_len == 13824, "got length %lu\n", nv12frame_data_len);
+        convert_nv12_frame(yuv_input_tests[i].subtype, nv12frame_data, yuv_data, actual_width, actual_height);
+
+        input_sample = create_sample(yuv_data, yuv_input_tests[i].sample_size);
+        hr = IMFSample_SetSampleTime(input_sample, 0);
+        ok(hr == S_OK, "SetSampleTime returned %#lx\n", hr);
+        hr = IMFSample_SetSampleDuration(input_sample, 10000000);
+        ok(hr == S_OK, "SetSampleDuration returned %#lx\n", hr);
+        hr = IMFTransform_ProcessInput(transform, 0, input_sample, 0);
+        ok(hr == S_OK, "ProcessInput returned %#lx\n", hr);
+        hr = IMFTransform_ProcessMessage(transform, MFT_MESSAGE_COMMAND_DRAIN, 0);
+        ok(hr == S_OK, "ProcessMessage returned %#lx\n", hr);
+        ret = IMFSample_Release(input_sample);
+        ok(ret <= 1, "Release returned %ld\n", ret);
+
+        hr = MFCreateCollection(&output_samples);
+        ok(hr == S_OK, "MFCreateCollection returned %#lx\n", hr);
+
+        output_sample = create_sample(NULL, output_info.cbSize);
+        hr = check_mft_process_output(transform, output_sample, &output_status);
+        ok(hr == S_OK, "ProcessOutput returned %#lx\n", hr);
+        ok(output_status == 0, "got output[0].dwStatus %#lx\n", output_status);
+        hr = IMFCollection_AddElement(output_samples, (IUnknown *)output_sample);
+        ok(hr == S_OK, "AddElement returned %#lx\n", hr);
+        ref = IMFSample_Release(output_sample);
+        ok(ref == 1, "Release returned %ld\n", ref);
+
+        ret = check_mf_sample_collection(output_samples, &output_sample_desc, L"rgb32frame.bmp");
+        ok(ret <= yuv_input_tests[i].delta, "got %lu%% diff\n", ret);
+        IMFCollection_Release(output_samples);
+        winetest_pop_context();
+    }
+
     ret = IMFTransform_Release(transform);
     ok(ret == 0, "Release returned %ld\n", ret);
 
@@ -475,20 +475,17 @@ static ULONG WINAPI client_Release(IAudioClient3 *iface)
     return ref;
 }
 
-static HRESULT WINAPI client_Initialize(IAudioClient3 *iface, AUDCLNT_SHAREMODE mode, DWORD flags,
+/* In shared mode, a non-zero period is only passed down by
+ * InitializeSharedAudioStream, to request a specific engine period. */
+static HRESULT initialize_stream(struct audio_client *This, AUDCLNT_SHAREMODE mode, DWORD flags,
                                  REFERENCE_TIME duration, REFERENCE_TIME period,
                                  const WAVEFORMATEX *fmt, const GUID *sessionguid)
 {
-    struct audio_client *This = impl_from_IAudioClient3(iface);
     struct create_stream_params params;
     UINT32 i, channel_count;
     stream_handle stream;
     WCHAR *name;
 
-    TRACE("(%p)->(%x, %lx, %s, %s, %p, %s)\n", This, mode, flags, wine_dbgstr_longlong(duration),
-                                               wine_dbgstr_longlong(period), fmt,
-                                               debugstr_guid(sessionguid));
-
     if (!fmt)
         return E_POINTER;
 
@@ -570,6 +567,23 @@ exit:
     return params.result;
 }
 
+static HRESULT WINAPI client_Initialize(IAudioClient3 *iface, AUDCLNT_SHAREMODE mode, DWORD flags,
+                                 REFERENCE_TIME duration, REFERENCE_TIME period,
+                                 const WAVEFORMATEX *fmt, const GUID *sessionguid)
+{
+    struct audio_client *This = impl_from_IAudioClient3(iface);
+
+    TRACE("(%p)->(%x, %lx, %s, %s, %p, %s)\n", This, mode, flags, wine_dbgstr_longlong(duration),
+                                               wine_dbgstr_longlong(period), fmt,
+                                               debugstr_guid(sessionguid));
+
+    /* The periodicity is ignored in shared mode. */
+    if (mode == AUDCLNT_SHAREMODE_SHARED)
+        period = 0;
+
+    return initialize_stream(This, mode, flags, duration, period, fmt, sessionguid);
+}
+
 static HRESULT WINAPI client_GetBufferSize(IAudioClient3 *iface, UINT32 *out)
 {
     struct audio_client *This = impl_from_IAudioClient3(iface);
@@ -930,6 +944,46 @@ static HRESULT WINAPI client_GetBufferSizeLimits(IAudioClient3 *iface, const WAV
     return E_NOTIMPL;
 }
 
+static UINT32 gcd(UINT32 a, UINT32 b)
+{
+    while (b)
+    {
+        UINT32 t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/* The backends accept any shared mode period between their minimum and
+ * default periods. Round the limits inwards, so that every period in frames
+ * between them converts to a period the backend keeps. */
+static HRESULT get_engine_period_frames(struct audio_client *This, DWORD rate, UINT32 *default_frames,
+                                        UINT32 *unit_frames, UINT32 *min_frames)
+{
+    struct get_device_period_params params;
+    REFERENCE_TIME def_period, min_period;
+
+    params.device     = This->device_name;
+    params.flow       = This->dataflow;
+    params.def_period = &def_period;
+    params.min_period = &min_period;
+
+    wine_unix_call(get_device_period, &params);
+    if (FAILED(params.result))
+        return params.result;
+
+    *default_frames = def_period * rate / 10000000;
+    *min_frames = (min_period * rate + 9999999) / 10000000;
+    if (!*default_frames)
+        *default_frames = 1;
+    if (!*min_frames || *min_frames > *default_frames)
+        *min_frames = *default_frames;
+    *unit_frames = gcd(*default_frames, *min_frames);
+
+    return S_OK;
+}
+
 static HRESULT WINAPI client_GetSharedModeEnginePeriod(IAudioClient3 *iface,
                                                 const WAVEFORMATEX *format,
                                                 UINT32 *default_period_frames,
@@ -938,10 +992,26 @@ static HRESULT WINAPI client_GetSharedModeEnginePeriod(IAudioClient3 *iface,
                                                 UINT32 *max_period_frames)
 {
     struct audio_client *This = impl_from_IAudioClient3(iface);
-    FIXME("(%p)->(%p, %p, %p, %p, %p) - stub\n", This, format, default_period_frames,
-                                                 unit_period_frames, min_period_frames,
-                                                 max_period_frames);
-    return E_NOTIMPL;
+    UINT32 def_frames, unit_frames, min_frames;
+    HRESULT hr;
+
+    TRACE("(%p)->(%p, %p, %p, %p, %p)\n", This, format, default_period_frames,
+                                           unit_period_frames, min_period_frames,
+                                           max_period_frames);
+
+    if (!format || !default_period_frames || !unit_period_frames ||
+        !min_period_frames || !max_period_frames)
+        return E_POINTER;
+
+    if (FAILED(hr = get_engine_period_frames(This, format->nSamplesPerSec, &def_frames, &unit_frames, &min_frames)))
+        return hr;
+
+    *default_period_frames = def_frames;
+    *unit_period_frames = unit_frames;
+    *min_period_frames = min_frames;
+    *max_period_frames = def_frames;
+
+    return S_OK;
 }
 
 static HRESULT WINAPI client_GetCurrentSharedModeEnginePeriod(IAudioClient3 *iface,
@@ -949,8 +1019,28 @@ static HRESULT WINAPI client_GetCurrentSharedModeEnginePeriod(IAudioClient3 *ifa
                                                        UINT32 *cur_period_frames)
 {
     struct audio_client *This = impl_from_IAudioClient3(iface);
-    FIXME("(%p)->(%p, %p) - stub\n", This, cur_format, cur_period_frames);
-    return E_NOTIMPL;
+    UINT32 def_frames, unit_frames, min_frames;
+    HRESULT hr;
+
+    TRACE("(%p)->(%p, %p)\n", This, cur_format, cur_period_frames);
+
+    if (!cur_format || !cur_period_frames)
+        return E_POINTER;
+
+    if (FAILED(hr = client_GetMixFormat(iface, cur_format)))
+        return hr;
+
+    if (FAILED(hr = get_engine_period_frames(This, (*cur_format)->nSamplesPerSec,
+                                             &def_frames, &unit_frames, &min_frames)))
+    {
+        CoTaskMemFree(*cur_format);
+        *cur_format = NULL;
+        return hr;
+    }
+
+    *cur_period_frames = def_frames;
+
+    return S_OK;
 }
 
 static HRESULT WINAPI client_InitializeSharedAudioStream(IAudioClient3 *iface, DWORD flags,
@@ -959,8 +1049,28 @@ static HRESULT WINAPI client_InitializeSharedAudioStream(IAudioClient3 *iface, D
                                                   const GUID *session_guid)
 {
     struct audio_client *This = impl_from_IAudioClient3(iface);
-    FIXME("(%p)->(0x%lx, %u, %p, %s) - stub\n", This, flags, period_frames, format, debugstr_guid(session_guid));
-    return E_NOTIMPL;
+    UINT32 def_frames, unit_frames, min_frames;
+    REFERENCE_TIME period;
+    HRESULT hr;
+
+    TRACE("(%p)->(0x%lx, %u, %p, %s)\n", This, flags, period_frames, format, debugstr_guid(session_guid));
+
+    if (!format)
+        return E_POINTER;
+
+    if (!format->nSamplesPerSec)
+        return E_INVALIDARG;
+
+    if (FAILED(hr = get_engine_period_frames(This, format->nSamplesPerSec, &def_frames, &unit_frames, &min_frames)))
+        return hr;
+
+    if (period_frames < min_frames || period_frames > def_frames || period_frames % unit_frames)
+        return E_INVALIDARG;
+
+    /* Round up, so that the backend converts it back to the same number of frames. */
+    period = ((REFERENCE_TIME)period_frames * 10000000 + format->nSamplesPerSec - 1) / format->nSamplesPerSec;
+
+    return initialize_stream(This, AUDCLNT_SHAREMODE_SHARED, flags, 0, period, format, session_guid);
 }
 
 const IAudioClient3Vtbl AudioClient3_Vtbl =
@@ -772,6 +772,75 @@ static void test_event(void)
     CloseHandle(event);
 }
 
+static void test_shared_engine_period(void)
+{
+    UINT32 def_period, unit_period, min_period, max_period, cur_period, frames, period;
+    WAVEFORMATEX *pwfx, *cur_fmt;
+    IAudioClient3 *ac3;
+    HRESULT hr;
+
+    hr = IMMDevice_Activate(dev, &IID_IAudioClient3, CLSCTX_INPROC_SERVER,
+            NULL, (void**)&ac3);
+    if(hr != S_OK){
+        win_skip("IAudioClient3 is not present on Win <= 8\n");
+        return;
+    }
+
+    hr = IAudioClient3_GetMixFormat(ac3, &pwfx);
+    ok(hr == S_OK, "GetMixFormat failed: %08lx\n", hr);
+
+    hr = IAudioClient3_GetSharedModeEnginePeriod(ac3, pwfx, NULL, &unit_period, &min_period, &max_period);
+    ok(hr == E_POINTER, "GetSharedModeEnginePeriod returns %08lx\n", hr);
+
+    hr = IAudioClient3_GetSharedModeEnginePeriod(ac3, pwfx, &def_period, &unit_period, &min_period, &max_period);
+    ok(hr == S_OK, "GetSharedModeEnginePeriod failed: %08lx\n", hr);
+    ok(unit_period > 0, "Got unit period %u\n", unit_period);
+    ok(min_period <= def_period, "Got minimum period %u, default %u\n", min_period, def_period);
+    ok(def_period <= max_period, "Got default period %u, maximum %u\n", def_period, max_period);
+    ok(!(min_period % unit_period), "Minimum period %u isn't a multiple of %u\n", min_period, unit_period);
+
+    hr = IAudioClient3_GetCurrentSharedModeEnginePeriod(ac3, &cur_fmt, &cur_period);
+    ok(hr == S_OK, "GetCurrentSharedModeEnginePeriod failed: %08lx\n", hr);
+    ok(cur_period >= min_period && cur_period <= max_period, "Got current period %u\n", cur_period);
+    CoTaskMemFree(cur_fmt);
+
+    ok(!(def_period % unit_period), "Default period %u isn't a multiple of %u\n", def_period, unit_period);
+
+    hr = IAudioClient3_InitializeSharedAudioStream(ac3, 0, min_period, pwfx, NULL);
+    ok(hr == S_OK, "InitializeSharedAudioStream failed: %08lx\n", hr);
+
+    hr = IAudioClient3_GetBufferSize(ac3, &frames);
+    ok(hr == S_OK, "GetBufferSize failed: %08lx\n", hr);
+    ok(frames >= min_period, "Got buffer size %u, period %u\n", frames, min_period);
+
+    hr = IAudioClient3_InitializeSharedAudioStream(ac3, 0, min_period, pwfx, NULL);
+    ok(hr == AUDCLNT_E_ALREADY_INITIALIZED, "InitializeSharedAudioStream returns %08lx\n", hr);
+
+    IAudioClient3_Release(ac3);
+
+    /* Every multiple of the unit period up to the maximum is accepted, including the default. */
+    for (period = min_period; period <= max_period; period += unit_period)
+    {
+        winetest_push_context("period %u", period);
+
+        hr = IMMDevice_Activate(dev, &IID_IAudioClient3, CLSCTX_INPROC_SERVER, NULL, (void**)&ac3);
+        ok(hr == S_OK, "Activation failed with %08lx\n", hr);
+
+        hr = IAudioClient3_InitializeSharedAudioStream(ac3, 0, period, pwfx, NULL);
+        ok(hr == S_OK, "InitializeSharedAudioStream failed: %08lx\n", hr);
+
+        hr = IAudioClient3_GetBufferSize(ac3, &frames);
+        ok(hr == S_OK, "GetBufferSize failed: %08lx\n", hr);
+        ok(frames >= period, "Got buffer size %u\n", frames);
+
+        IAudioClient3_Release(ac3);
+
+        winetest_pop_context();
+    }
+
+    CoTaskMemFree(pwfx);
+}
+
 static void test_padding(void)
 {
     HRESULT hr;
@@ -2404,6 +2473,7 @@ START_TEST(render)
         trace("Please redirect output to a file.\n");
     }
     test_event();
+    test_shared_engine_period();
     test_padding();
     test_clock(1);
     test_clock(0);
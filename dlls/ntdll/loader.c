@@ -95,6 +95,7 @@ static const WCHAR system_path[] = L"C:\\windows\\system32;C:\\windows\\system;C
 static BOOL is_prefix_bootstrap;  /* are we bootstrapping the prefix? */
 static BOOL imports_fixup_done = FALSE;  /* set once the imports have been fixed up, before attaching them */
 static BOOL process_detaching = FALSE;  /* set on process detach to avoid deadlocks with thread detach */
+static BOOL startup_timeline = FALSE;  /* report startup phases to the unix side */
 static int free_lib_count;   /* recursion depth of LdrUnloadDll calls */
 static LONG path_safe_mode;  /* path mode set by RtlSetSearchPathMode */
 static LONG dll_safe_mode = 1;  /* dll search mode */
@@ -4480,6 +4481,8 @@ void loader_init( CONTEXT *context, void **entry )
             ERR( "Enabling heap zero hack.\n" );
             heap_zero_hack = TRUE;
         }
+        if (get_env( L"WINE_STARTUP_TIMELINE", env_str, sizeof(env_str)) && wcstoul( env_str, NULL, 10 ))
+            startup_timeline = TRUE;
 
         peb->ProcessHeap        = RtlCreateHeap( heap_flags, NULL, 0, 0, NULL, NULL );
 
@@ -4523,6 +4526,7 @@ void loader_init( CONTEXT *context, void **entry )
             NtTerminateProcess( GetCurrentProcess(), status );
         }
         imports_fixup_done = TRUE;
+        if (startup_timeline) WINE_UNIX_CALL( unix_startup_phase, "imports_fixed" );
     }
     else wm = get_modref( NtCurrentTeb()->Peb->ImageBaseAddress );
 
@@ -4569,6 +4573,7 @@ void loader_init( CONTEXT *context, void **entry )
         release_address_space();
         if (wm->ldr.TlsIndex == -1) call_tls_callbacks( wm->ldr.DllBase, DLL_PROCESS_ATTACH );
         if (wm->ldr.ActivationContext) RtlDeactivateActivationContext( 0, cookie );
+        if (startup_timeline) WINE_UNIX_CALL( unix_startup_phase, "entry" );
         process_breakpoint();
     }
     else
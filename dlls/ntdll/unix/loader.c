@@ -641,6 +641,26 @@ NTSTATUS exec_wineloader( char **argv, int socketfd, const pe_image_info_t *pe_i
 }
 
 
+/***********************************************************************
+ *           exec_zygote
+ *
+ * Exec a wine loader that waits for a process to start on zygote_fd.
+ * argv[0] and argv[1] must be reserved for the preloader and loader respectively.
+ */
+NTSTATUS exec_zygote( char **argv, int zygote_fd, WORD machine )
+{
+    char zygote_env[64];
+
+    signal( SIGPIPE, SIG_DFL );
+
+    snprintf( zygote_env, sizeof(zygote_env), "WINEZYGOTESOCKET=%u", zygote_fd );
+    unsetenv( "WINEPRELOADRESERVE" );
+    putenv( zygote_env );
+
+    return loader_exec( argv, machine );
+}
+
+
 /***********************************************************************
  *           exec_wineserver
  *
@@ -1173,6 +1193,51 @@ const char * wine_debuginfostr_pc( void *pc )
     return __wine_dbg_strdup( buffer );
 }
 
+BOOL startup_timeline = FALSE;
+LONG startup_server_calls = 0;
+LONG startup_mmap_calls = 0;
+static struct timespec startup_time;
+
+/***********************************************************************
+ *           init_startup_timeline
+ *
+ * Start recording the startup timeline if WINE_STARTUP_TIMELINE is set.
+ */
+static void init_startup_timeline(void)
+{
+    const char *env = getenv( "WINE_STARTUP_TIMELINE" );
+
+    if (!env || !atoi( env )) return;
+    clock_gettime( CLOCK_MONOTONIC, &startup_time );
+    startup_timeline = TRUE;
+}
+
+/***********************************************************************
+ *           startup_timeline_phase
+ *
+ * Print the time elapsed since process start along with the number of server
+ * calls and mmap calls made so far. The last phase stops the timeline.
+ */
+void startup_timeline_phase( const char *name )
+{
+    struct timespec now;
+    ULONGLONG elapsed;
+
+    if (!startup_timeline) return;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    elapsed = (now.tv_sec - startup_time.tv_sec) * (ULONGLONG)1000000 + (now.tv_nsec - startup_time.tv_nsec) / 1000;
+    MESSAGE( "wine: startup pid %04x %-16s %5u.%03u ms %6d server calls %6d mmaps\n",
+             (int)getpid(), name, (unsigned int)(elapsed / 1000), (unsigned int)(elapsed % 1000),
+             (int)startup_server_calls, (int)startup_mmap_calls );
+    if (!strcmp( name, "entry" )) startup_timeline = FALSE;
+}
+
+static NTSTATUS startup_phase( void *args )
+{
+    startup_timeline_phase( args );
+    return STATUS_SUCCESS;
+}
+
 static BOOL report_native_pc_as_ntdll;
 
 static NTSTATUS is_pc_in_native_so(void *pc)
@@ -1198,6 +1263,7 @@ static const unixlib_entry_t unix_call_funcs[] =
     unixcall_wine_server_handle_to_fd,
     unixcall_wine_spawnvp,
     system_time_precise,
+    startup_phase,
     steamclient_setup_trampolines,
     is_pc_in_native_so,
     debugstr_pc,
@@ -1219,6 +1285,7 @@ const unixlib_entry_t unix_call_wow64_funcs[] =
     wow64_wine_server_handle_to_fd,
     wow64_wine_spawnvp,
     system_time_precise,
+    startup_phase,
 };
 
 #endif  /* _WIN64 */
@@ -2167,8 +2234,10 @@ static void start_main_thread(void)
 
     signal_init_threading();
     signal_alloc_thread( teb );
+    zygote_wait();
     dbg_init();
     startup_info_size = server_init_process();
+    startup_timeline_phase( "server_init" );
     hacks_init();
     fsync_init();
     esync_init();
@@ -2186,6 +2255,7 @@ static void start_main_thread(void)
     load_ntdll();
     load_wow64_ntdll( main_image_info.Machine );
     load_apiset_dll();
+    startup_timeline_phase( "ntdll_loaded" );
     server_init_process_done();
 }
 
@@ -2495,6 +2565,7 @@ DECLSPEC_EXPORT void __wine_main( int argc, char *argv[], char *envp[] )
     main_argv = argv;
     main_envp = envp;
 
+    init_startup_timeline();
     init_paths( argv );
 
     if (!getenv( "WINELOADERNOEXEC" ))  /* first time around */
@@ -2524,6 +2595,7 @@ DECLSPEC_EXPORT void __wine_main( int argc, char *argv[], char *envp[] )
 
     virtual_init();
     init_environment();
+    startup_timeline_phase( "virtual_init" );
 
 #ifdef __APPLE__
     apple_main_thread();
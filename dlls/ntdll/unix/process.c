@@ -34,6 +34,9 @@
 #include <string.h>
 #include <time.h>
 #include <sys/socket.h>
+#ifdef HAVE_SYS_SYSCALL_H
+# include <sys/syscall.h>
+#endif
 #include <sys/time.h>
 #ifdef HAVE_SYS_TIMES_H
 # include <sys/times.h>
@@ -418,6 +421,302 @@ static BOOL is_unix_console_handle( HANDLE handle )
 }
 
 
+/* Zygote processes
+ *
+ * When WINE_PROCESS_ZYGOTE is set, a wine loader is started ahead of time and
+ * left waiting right before connecting to the server, with the unix side of
+ * ntdll already loaded and initialized. The next process with a matching
+ * machine is then started by sending it the server socket, the stdio and
+ * current directory fds and the command line, which skips the exec of the
+ * preloader and the unix initialization on the critical path. Since the
+ * zygote can't reserve the address range of the main image in advance, it is
+ * only used for images that can be relocated.
+ */
+
+#define ZYGOTE_NEW_SESSION 0x01
+#define ZYGOTE_STDIN       0x02
+#define ZYGOTE_STDOUT      0x04
+#define ZYGOTE_UNIXDIR     0x08
+
+struct zygote_request
+{
+    unsigned int flags;          /* ZYGOTE_* flags */
+    unsigned int cmdline_len;    /* size of the command line, in bytes */
+    unsigned int winedebug_len;  /* size of the WINEDEBUG variable, including the null terminator */
+};
+
+static pthread_mutex_t zygote_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int zygote_fd = -1;
+static WORD zygote_machine;
+static int use_zygote = -1;
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#ifndef MSG_CMSG_CLOEXEC
+#define MSG_CMSG_CLOEXEC 0
+#endif
+
+static BOOL zygote_enabled(void)
+{
+    if (use_zygote == -1)
+    {
+        const char *env = getenv( "WINE_PROCESS_ZYGOTE" );
+        use_zygote = env && atoi( env );
+    }
+    return use_zygote;
+}
+
+static WORD get_loader_machine( const pe_image_info_t *pe_info )
+{
+    if (pe_info->image_flags & IMAGE_FLAGS_ComPlusNativeReady) return native_machine;
+    return pe_info->machine;
+}
+
+/***********************************************************************
+ *           close_inherited_fds
+ *
+ * Close all the fds above stderr except keep_fd. The zygote outlives the
+ * process being started, so it must not hold on to the fds passed to that
+ * process, nor to any other fd it inherited; stdio is replaced once the
+ * zygote gets its request.
+ */
+static void close_inherited_fds( int keep_fd )
+{
+    int fd, max_fd;
+
+#if defined(__linux__) && defined(__NR_close_range)
+    /* the fd limit is raised to the maximum, avoid looping over it if possible */
+    if ((keep_fd <= 3 || !syscall( __NR_close_range, 3, keep_fd - 1, 0 )) &&
+        !syscall( __NR_close_range, max( keep_fd + 1, 3 ), ~0u, 0 ))
+        return;
+#endif
+    max_fd = sysconf( _SC_OPEN_MAX );
+    for (fd = 3; fd < max_fd; fd++) if (fd != keep_fd) close( fd );
+}
+
+/***********************************************************************
+ *           start_zygote
+ *
+ * Start a zygote process for the specified machine.
+ */
+static void start_zygote( WORD machine )
+{
+    int fds[2];
+    pid_t pid;
+
+    if (socketpair( PF_UNIX, SOCK_STREAM, 0, fds ) == -1) return;
+    fcntl( fds[0], F_SETFD, FD_CLOEXEC );
+
+    if (!(pid = fork()))  /* child */
+    {
+        if (!(pid = fork()))  /* grandchild */
+        {
+            char *argv[3] = { NULL };
+
+            close_inherited_fds( fds[1] );
+            exec_zygote( argv, fds[1], machine );
+            _exit(1);
+        }
+        _exit(pid == -1);
+    }
+    close( fds[1] );
+
+    if (pid != -1)
+    {
+        /* reap child */
+        pid_t wret;
+        do {
+            wret = waitpid(pid, NULL, 0);
+        } while (wret < 0 && errno == EINTR);
+
+        zygote_fd = fds[0];
+        zygote_machine = machine;
+    }
+    else close( fds[0] );
+}
+
+static BOOL send_zygote_data( int fd, const void *data, size_t size )
+{
+    size_t pos;
+    ssize_t ret;
+
+    for (pos = 0; pos < size; pos += ret)
+        if ((ret = send( fd, (const char *)data + pos, size - pos, MSG_NOSIGNAL )) <= 0) return FALSE;
+    return TRUE;
+}
+
+/***********************************************************************
+ *           spawn_zygote_process
+ *
+ * Hand the new process over to a waiting zygote.
+ */
+static BOOL spawn_zygote_process( const RTL_USER_PROCESS_PARAMETERS *params, int socketfd, int unixdir,
+                                  const char *winedebug, const pe_image_info_t *pe_info,
+                                  int stdin_fd, int stdout_fd, BOOL new_session )
+{
+    static const WCHAR explorerW[] = {'\\','e','x','p','l','o','r','e','r','.','e','x','e'};
+    const UNICODE_STRING *image = &params->ImagePathName;
+    WORD machine = get_loader_machine( pe_info );
+    struct zygote_request req;
+    char control[CMSG_SPACE( 4 * sizeof(int) )];
+    struct cmsghdr *cmsg;
+    struct msghdr msg;
+    struct iovec vec;
+    int fds[4], count = 0, fd;
+    BOOL ret = FALSE;
+
+    if (!zygote_enabled()) return FALSE;
+    if (!(pe_info->image_flags & IMAGE_FLAGS_ImageDynamicallyRelocated) && !pe_info->wine_fakedll) return FALSE;
+    /* explorer needs a different LD_PRELOAD, see exec_wineloader */
+    if (image->Length >= sizeof(explorerW) &&
+        !ntdll_wcsnicmp( image->Buffer + (image->Length - sizeof(explorerW)) / sizeof(WCHAR),
+                         explorerW, ARRAY_SIZE(explorerW) ))
+        return FALSE;
+
+    pthread_mutex_lock( &zygote_mutex );
+    if (zygote_fd != -1 && zygote_machine != machine)
+    {
+        close( zygote_fd );
+        zygote_fd = -1;
+    }
+    fd = zygote_fd;
+    zygote_fd = -1;
+    pthread_mutex_unlock( &zygote_mutex );
+
+    if (fd != -1)
+    {
+        req.flags = new_session ? ZYGOTE_NEW_SESSION : 0;
+        req.cmdline_len = params->CommandLine.Length;
+        req.winedebug_len = winedebug ? strlen( winedebug ) + 1 : 0;
+
+        fds[count++] = socketfd;
+        if (!new_session && stdin_fd != -1)
+        {
+            req.flags |= ZYGOTE_STDIN;
+            fds[count++] = stdin_fd;
+        }
+        if (!new_session && stdout_fd != -1)
+        {
+            req.flags |= ZYGOTE_STDOUT;
+            fds[count++] = stdout_fd;
+        }
+        if (unixdir != -1)
+        {
+            req.flags |= ZYGOTE_UNIXDIR;
+            fds[count++] = unixdir;
+        }
+
+        vec.iov_base = &req;
+        vec.iov_len  = sizeof(req);
+        memset( &msg, 0, sizeof(msg) );
+        msg.msg_iov        = &vec;
+        msg.msg_iovlen     = 1;
+        msg.msg_control    = control;
+        msg.msg_controllen = CMSG_SPACE( count * sizeof(int) );
+        cmsg = CMSG_FIRSTHDR( &msg );
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type  = SCM_RIGHTS;
+        cmsg->cmsg_len   = CMSG_LEN( count * sizeof(int) );
+        memcpy( CMSG_DATA(cmsg), fds, count * sizeof(int) );
+
+        ret = (sendmsg( fd, &msg, MSG_NOSIGNAL ) == sizeof(req) &&
+               send_zygote_data( fd, params->CommandLine.Buffer, req.cmdline_len ) &&
+               send_zygote_data( fd, winedebug, req.winedebug_len ));
+        close( fd );
+        if (!ret) WARN( "failed to start process in zygote\n" );
+    }
+
+    /* prepare a zygote for the next process */
+    pthread_mutex_lock( &zygote_mutex );
+    if (zygote_fd == -1) start_zygote( machine );
+    pthread_mutex_unlock( &zygote_mutex );
+    return ret;
+}
+
+/***********************************************************************
+ *           zygote_wait
+ *
+ * Wait for a process to start, when running as a zygote.
+ */
+void zygote_wait(void)
+{
+    const char *env = getenv( "WINEZYGOTESOCKET" );
+    char control[CMSG_SPACE( 4 * sizeof(int) )], socket_env[64];
+    struct zygote_request req;
+    UNICODE_STRING cmdline;
+    struct cmsghdr *cmsg;
+    struct msghdr msg;
+    struct iovec vec;
+    int fd, fds[4], count = 0, stdin_fd = -1, stdout_fd = -1, i;
+    char *winedebug = NULL, **argv;
+    size_t pos;
+    ssize_t ret;
+
+    if (!env) return;
+    fd = atoi( env );
+    unsetenv( "WINEZYGOTESOCKET" );
+
+    vec.iov_base = &req;
+    vec.iov_len  = sizeof(req);
+    memset( &msg, 0, sizeof(msg) );
+    msg.msg_iov        = &vec;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+
+    do ret = recvmsg( fd, &msg, MSG_CMSG_CLOEXEC ); while (ret == -1 && errno == EINTR);
+    if (ret != sizeof(req)) _exit(0);  /* parent is gone */
+
+    for (cmsg = CMSG_FIRSTHDR( &msg ); cmsg; cmsg = CMSG_NXTHDR( &msg, cmsg ))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+        count = min( (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int), ARRAY_SIZE(fds) );
+        memcpy( fds, CMSG_DATA(cmsg), count * sizeof(int) );
+    }
+    if (!count) _exit(1);
+
+    cmdline.Length = cmdline.MaximumLength = req.cmdline_len;
+    if (!(cmdline.Buffer = malloc( req.cmdline_len ))) _exit(1);
+    if (req.winedebug_len && !(winedebug = malloc( req.winedebug_len ))) _exit(1);
+    for (pos = 0; pos < req.cmdline_len; pos += ret)
+        if ((ret = read( fd, (char *)cmdline.Buffer + pos, req.cmdline_len - pos )) <= 0) _exit(1);
+    for (pos = 0; pos < req.winedebug_len; pos += ret)
+        if ((ret = read( fd, winedebug + pos, req.winedebug_len - pos )) <= 0) _exit(1);
+    close( fd );
+
+    i = 1;
+    if (req.flags & ZYGOTE_STDIN) stdin_fd = fds[i++];
+    if (req.flags & ZYGOTE_STDOUT) stdout_fd = fds[i++];
+    if (req.flags & ZYGOTE_NEW_SESSION)
+    {
+        setsid();
+        set_stdio_fd( -1, -1 );  /* close stdin and stdout */
+    }
+    else set_stdio_fd( stdin_fd, stdout_fd );
+
+    if (stdin_fd != -1 && stdin_fd != 0) close( stdin_fd );
+    if (stdout_fd != -1 && stdout_fd != 1) close( stdout_fd );
+
+    if (winedebug) putenv( winedebug );
+    if (req.flags & ZYGOTE_UNIXDIR)
+    {
+        fchdir( fds[i] );
+        close( fds[i] );
+    }
+
+    snprintf( socket_env, sizeof(socket_env), "WINESERVERSOCKET=%u", fds[0] );
+    putenv( strdup( socket_env ));
+
+    argv = build_argv( &cmdline, 1 );
+    argv[0] = main_argv[0];
+    for (main_argc = 0; argv[main_argc]; main_argc++) ;
+    main_argv = argv;
+    free( cmdline.Buffer );
+
+    startup_timeline_phase( "zygote_start" );
+}
+
 /***********************************************************************
  *           spawn_process
  */
@@ -426,6 +725,7 @@ static NTSTATUS spawn_process( const RTL_USER_PROCESS_PARAMETERS *params, int so
 {
     NTSTATUS status = STATUS_SUCCESS;
     int stdin_fd = -1, stdout_fd = -1;
+    BOOL new_session;
     pid_t pid;
     char **argv;
 
@@ -437,14 +737,18 @@ static NTSTATUS spawn_process( const RTL_USER_PROCESS_PARAMETERS *params, int so
         isatty(1) && is_unix_console_handle( params->hStdOutput ))
         stdout_fd = 1;
 
-    if (!(pid = fork()))  /* child */
+    new_session = ((peb->ProcessParameters && params->ProcessGroupId != peb->ProcessParameters->ProcessGroupId) ||
+                   params->ConsoleHandle == CONSOLE_HANDLE_ALLOC ||
+                   params->ConsoleHandle == CONSOLE_HANDLE_ALLOC_NO_WINDOW ||
+                   (params->hStdInput == INVALID_HANDLE_VALUE && params->hStdOutput == INVALID_HANDLE_VALUE));
+
+    if (spawn_zygote_process( params, socketfd, unixdir, winedebug, pe_info, stdin_fd, stdout_fd, new_session ))
+        pid = 0;
+    else if (!(pid = fork()))  /* child */
     {
         if (!(pid = fork()))  /* grandchild */
         {
-            if ((peb->ProcessParameters && params->ProcessGroupId != peb->ProcessParameters->ProcessGroupId) ||
-                params->ConsoleHandle == CONSOLE_HANDLE_ALLOC ||
-                params->ConsoleHandle == CONSOLE_HANDLE_ALLOC_NO_WINDOW ||
-                (params->hStdInput == INVALID_HANDLE_VALUE && params->hStdOutput == INVALID_HANDLE_VALUE))
+            if (new_session)
             {
                 setsid();
                 set_stdio_fd( -1, -1 );  /* close stdin and stdout */
@@ -469,7 +773,7 @@ static NTSTATUS spawn_process( const RTL_USER_PROCESS_PARAMETERS *params, int so
         _exit(pid == -1);
     }
 
-    if (pid != -1)
+    if (pid > 0)
     {
         /* reap child */
         pid_t wret;
@@ -477,7 +781,7 @@ static NTSTATUS spawn_process( const RTL_USER_PROCESS_PARAMETERS *params, int so
             wret = waitpid(pid, NULL, 0);
         } while (wret < 0 && errno == EINTR);
     }
-    else status = STATUS_NO_MEMORY;
+    else if (pid == -1) status = STATUS_NO_MEMORY;
 
     if (stdin_fd != -1 && stdin_fd != 0) close( stdin_fd );
     if (stdout_fd != -1 && stdout_fd != 1) close( stdout_fd );
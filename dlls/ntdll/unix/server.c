@@ -267,6 +267,7 @@ unsigned int server_call_unlocked( void *req_ptr )
 
     FTRACE_BLOCK_START("req %s", req->name)
     TRACE_(client)("%s start\n", req->name); \
+    if (startup_timeline) InterlockedIncrement( &startup_server_calls );
     if (!(ret = send_request( req )))
         ret = wait_reply( req );
     TRACE_(client)("%s end\n", req->name);
@@ -1727,6 +1728,7 @@ void server_init_process_done(void)
     SERVER_END_REQ;
 
     assert( !status );
+    startup_timeline_phase( "init_done" );
     signal_start_thread( entry, peb, suspend, NtCurrentTeb() );
 }
 
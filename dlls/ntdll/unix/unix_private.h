@@ -190,8 +190,12 @@ extern BOOL localsystem_sid;
 extern BOOL simulate_writecopy;
 extern long long ram_reporting_bias;
 extern BOOL wine_allocs_2g_limit;
+extern BOOL startup_timeline;
+extern LONG startup_server_calls;
+extern LONG startup_mmap_calls;
 
 extern void init_environment(void);
+extern void startup_timeline_phase( const char *name );
 extern void init_startup_info(void);
 extern void *create_startup_info( const UNICODE_STRING *nt_image, ULONG process_flags,
                                   const RTL_USER_PROCESS_PARAMETERS *params,
@@ -199,6 +203,8 @@ extern void *create_startup_info( const UNICODE_STRING *nt_image, ULONG process_
 extern char **build_envp( const WCHAR *envW );
 extern char *get_alternate_wineloader( WORD machine );
 extern NTSTATUS exec_wineloader( char **argv, int socketfd, const pe_image_info_t *pe_info );
+extern NTSTATUS exec_zygote( char **argv, int zygote_fd, WORD machine );
+extern void zygote_wait(void);
 extern NTSTATUS load_builtin( const pe_image_info_t *image_info, WCHAR *filename, USHORT machine,
                               void **addr_ptr, SIZE_T *size_ptr, ULONG_PTR limit_low, ULONG_PTR limit_high );
 extern BOOL is_builtin_path( const UNICODE_STRING *path, WORD *machine );
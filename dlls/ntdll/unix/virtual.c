@@ -370,12 +370,14 @@ static inline BOOL is_beyond_limit( const void *addr, size_t size, const void *l
 /* mmap() anonymous memory at a fixed address */
 void *anon_mmap_fixed( void *start, size_t size, int prot, int flags )
 {
+    if (startup_timeline) InterlockedIncrement( &startup_mmap_calls );
     return mmap( start, size, prot, MAP_PRIVATE | MAP_ANON | MAP_FIXED | flags, -1, 0 );
 }
 
 /* allocate anonymous mmap() memory at any address */
 void *anon_mmap_alloc( size_t size, int prot )
 {
+    if (startup_timeline) InterlockedIncrement( &startup_mmap_calls );
     return mmap( NULL, size, prot, MAP_PRIVATE | MAP_ANON, -1, 0 );
 }
 
@@ -770,6 +772,8 @@ static void *anon_mmap_tryfixed( void *start, size_t size, int prot, int flags )
 {
     void *ptr;
 
+    if (startup_timeline) InterlockedIncrement( &startup_mmap_calls );
+
 #ifdef MAP_FIXED_NOREPLACE
     ptr = mmap( start, size, prot, MAP_FIXED_NOREPLACE | MAP_PRIVATE | MAP_ANON | flags, -1, 0 );
 #elif defined(MAP_TRYFIXED)
@@ -2523,6 +2527,7 @@ static NTSTATUS map_file_into_view( struct file_view *view, int fd, size_t start
     /* only try mmap if media is not removable (or if we require write access) */
     if (!removable || (flags & MAP_SHARED))
     {
+        if (startup_timeline) InterlockedIncrement( &startup_mmap_calls );
         if (mmap( (char *)view->base + start, size, prot, flags, fd, offset ) != MAP_FAILED)
             goto done;
 
@@ -3140,7 +3145,7 @@ static IMAGE_BASE_RELOCATION *process_relocation_block( char *page, IMAGE_BASE_R
  */
 static NTSTATUS map_image_into_view( struct file_view *view, const WCHAR *filename, int fd,
                                      pe_image_info_t *image_info, USHORT machine,
-                                     int shared_fd, BOOL removable )
+                                     int shared_fd, BOOL removable, int reloc_fd, BOOL *reloc_ready )
 {
     IMAGE_DOS_HEADER *dos;
     IMAGE_NT_HEADERS *nt;
@@ -3205,6 +3210,15 @@ static NTSTATUS map_image_into_view( struct file_view *view, const WCHAR *filena
         return STATUS_SUCCESS;
     }
 
+    /* map the already relocated image, only the shared sections need to be mapped separately */
+
+    if (*reloc_ready)
+    {
+        TRACE_(module)( "mapping %s from relocated image cache\n", debugstr_w(filename) );
+        if (map_file_into_view( view, reloc_fd, 0, total_size, 0, VPROT_COMMITTED | VPROT_READ | VPROT_WRITECOPY,
+                                FALSE ) != STATUS_SUCCESS)
+            *reloc_ready = FALSE;
+    }
 
     /* map all the sections */
 
@@ -3262,6 +3276,8 @@ static NTSTATUS map_image_into_view( struct file_view *view, const WCHAR *filena
             continue;
         }
 
+        if (*reloc_ready) continue;
+
         TRACE_(module)( "mapping %s section %.8s at %p off %x size %x virt %x flags %x\n",
                         debugstr_w(filename), sec->Name, ptr + sec->VirtualAddress,
                         (int)sec->PointerToRawData, (int)sec->SizeOfRawData,
@@ -3315,7 +3331,7 @@ static NTSTATUS map_image_into_view( struct file_view *view, const WCHAR *filena
 
     /* relocate to dynamic base */
 
-    if (image_info->map_addr && (delta = image_info->map_addr - image_info->base))
+    if (!*reloc_ready && image_info->map_addr && (delta = image_info->map_addr - image_info->base))
     {
         TRACE_(module)( "relocating %s dynamic base %lx -> %lx mapped at %p\n", debugstr_w(filename),
                         (ULONG_PTR)image_info->base, (ULONG_PTR)image_info->map_addr, ptr );
@@ -3333,6 +3349,9 @@ static NTSTATUS map_image_into_view( struct file_view *view, const WCHAR *filena
             while (rel && rel < end - 1 && rel->SizeOfBlock && rel->VirtualAddress < total_size)
                 rel = process_relocation_block( ptr + rel->VirtualAddress, rel, delta );
         }
+
+        /* store the relocated image for other processes mapping the same file */
+        if (reloc_fd != -1 && pwrite( reloc_fd, ptr, total_size, 0 ) == total_size) *reloc_ready = TRUE;
     }
 
     /* set the image protections */
@@ -3475,6 +3494,52 @@ static NTSTATUS map_image_view( struct file_view **view_ret, pe_image_info_t *im
 }
 
 
+/***********************************************************************
+ *             get_image_reloc_cache
+ *
+ * Get the file caching the relocated contents of an image mapping.
+ */
+static HANDLE get_image_reloc_cache( HANDLE mapping, const pe_image_info_t *image_info, BOOL *ready )
+{
+    HANDLE file = 0;
+
+    if (!image_info->map_addr || image_info->map_addr == image_info->base) return 0;
+    if (image_info->image_flags & IMAGE_FLAGS_ImageMappedFlat) return 0;
+    /* ARM64X images are patched according to the process machine */
+    if (image_info->machine == IMAGE_FILE_MACHINE_ARM64) return 0;
+
+    SERVER_START_REQ( get_image_reloc_cache )
+    {
+        req->handle = wine_server_obj_handle( mapping );
+        req->addr   = image_info->map_addr;
+        if (!wine_server_call( req ))
+        {
+            file = wine_server_ptr_handle( reply->file );
+            *ready = reply->ready;
+        }
+    }
+    SERVER_END_REQ;
+    return file;
+}
+
+
+/***********************************************************************
+ *             set_image_reloc_cache
+ *
+ * Release the relocated image cache after trying to fill it.
+ */
+static void set_image_reloc_cache( HANDLE mapping, BOOL ready )
+{
+    SERVER_START_REQ( set_image_reloc_cache )
+    {
+        req->handle = wine_server_obj_handle( mapping );
+        req->ready  = ready;
+        wine_server_call( req );
+    }
+    SERVER_END_REQ;
+}
+
+
 /***********************************************************************
  *             virtual_map_image
  *
@@ -3487,8 +3552,11 @@ static NTSTATUS virtual_map_image( HANDLE mapping, void **addr_ptr, SIZE_T *size
 {
     int unix_fd = -1, needs_close;
     int shared_fd = -1, shared_needs_close = 0;
+    int reloc_fd = -1, reloc_needs_close = 0;
     SIZE_T size = image_info->map_size;
+    BOOL reloc_ready = FALSE, reloc_filling = FALSE;
     struct file_view *view;
+    HANDLE reloc_file;
     unsigned int status;
     sigset_t sigset;
 
@@ -3514,12 +3582,24 @@ static NTSTATUS virtual_map_image( HANDLE mapping, void **addr_ptr, SIZE_T *size
         SERVER_END_REQ;
     }
 
+    if ((reloc_file = get_image_reloc_cache( mapping, image_info, &reloc_ready )))
+    {
+        reloc_filling = !reloc_ready;
+        if (server_get_unix_fd( reloc_file, reloc_ready ? FILE_READ_DATA : FILE_READ_DATA|FILE_WRITE_DATA,
+                                &reloc_fd, &reloc_needs_close, NULL, NULL ))
+        {
+            reloc_fd = -1;
+            reloc_ready = FALSE;
+        }
+    }
+
     server_enter_uninterrupted_section( &virtual_mutex, &sigset );
 
     status = map_image_view( &view, image_info, size, limit_low, limit_high, alloc_type );
     if (status) goto done;
 
-    status = map_image_into_view( view, filename, unix_fd, image_info, machine, shared_fd, needs_close );
+    status = map_image_into_view( view, filename, unix_fd, image_info, machine, shared_fd, needs_close,
+                                  reloc_fd, &reloc_ready );
     if (status == STATUS_SUCCESS)
     {
         SERVER_START_REQ( map_image_view )
@@ -3544,6 +3624,9 @@ static NTSTATUS virtual_map_image( HANDLE mapping, void **addr_ptr, SIZE_T *size
 
 done:
     server_leave_uninterrupted_section( &virtual_mutex, &sigset );
+    if (reloc_filling) set_image_reloc_cache( mapping, NT_SUCCESS(status) && reloc_ready );
+    if (reloc_needs_close) close( reloc_fd );
+    if (reloc_file) NtClose( reloc_file );
     if (needs_close) close( unix_fd );
     if (shared_needs_close) close( shared_fd );
     return status;
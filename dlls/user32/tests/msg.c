@@ -5415,6 +5415,26 @@ static void test_MsgWaitForMultipleObjects(HWND hwnd)
     ok(PeekMessageA( &msg, 0, 0, 0, PM_REMOVE ), "PeekMessage should succeed\n");
     ok(msg.message == WM_USER, "got %04x instead of WM_USER\n", msg.message);
 
+    /* waiting doesn't clear the changed bits, only checking the queue does */
+    PostThreadMessageA( GetCurrentThreadId(), WM_USER, 0, 0 );
+
+    ret = MsgWaitForMultipleObjects(0, NULL, FALSE, 0, QS_ALLPOSTMESSAGE);
+    ok(ret == WAIT_OBJECT_0, "MsgWaitForMultipleObjects returned %lx\n", ret);
+    ret = MsgWaitForMultipleObjects(0, NULL, FALSE, 0, QS_ALLPOSTMESSAGE);
+    ok(ret == WAIT_OBJECT_0, "MsgWaitForMultipleObjects returned %lx\n", ret);
+
+    ok(PeekMessageA( &msg, 0, 0, 0, PM_NOREMOVE ), "PeekMessage should succeed\n");
+    ok(msg.message == WM_USER, "got %04x instead of WM_USER\n", msg.message);
+
+    /* the message is still queued, but it has been seen */
+    ret = MsgWaitForMultipleObjects(0, NULL, FALSE, 50, QS_ALLPOSTMESSAGE);
+    ok(ret == WAIT_TIMEOUT, "MsgWaitForMultipleObjects returned %lx\n", ret);
+    ret = MsgWaitForMultipleObjects(0, NULL, FALSE, 50, QS_POSTMESSAGE);
+    ok(ret == WAIT_TIMEOUT, "MsgWaitForMultipleObjects returned %lx\n", ret);
+
+    ok(PeekMessageA( &msg, 0, 0, 0, PM_REMOVE ), "PeekMessage should succeed\n");
+    ok(msg.message == WM_USER, "got %04x instead of WM_USER\n", msg.message);
+
     /* without MWMO_ALERTABLE the result is never WAIT_IO_COMPLETION */
     ret = QueueUserAPC( apc_test_proc, GetCurrentThread(), 0 );
     ok(ret, "QueueUserAPC failed %lu\n", GetLastError());
@@ -17983,6 +18003,49 @@ static void test_PostMessage(void)
     flush_events();
 }
 
+static DWORD CALLBACK post_message_thread( void *arg )
+{
+    HWND hwnd = arg;
+    PostMessageA( hwnd, WM_USER + 2, 2, 0 );
+    return 0;
+}
+
+static void test_PostMessage_order(void)
+{
+    HANDLE thread;
+    DWORD status;
+    HWND hwnd;
+    BOOL ret;
+    MSG msg;
+    int i;
+
+    hwnd = CreateWindowExA( 0, "static", NULL, WS_POPUP, 0, 0, 0, 0, 0, 0, 0, NULL );
+    ok( !!hwnd, "Failed to create window, error %lu.\n", GetLastError() );
+    flush_events();
+
+    /* messages posted from the current thread and from another one are retrieved in order */
+    PostMessageA( hwnd, WM_USER + 1, 1, 0 );
+    status = GetQueueStatus( QS_POSTMESSAGE );
+    ok( status == MAKELONG( QS_POSTMESSAGE, QS_POSTMESSAGE ), "got status %#lx\n", status );
+    thread = CreateThread( NULL, 0, post_message_thread, hwnd, 0, NULL );
+    ok( WaitForSingleObject( thread, 5000 ) == WAIT_OBJECT_0, "thread didn't exit\n" );
+    CloseHandle( thread );
+    PostMessageA( hwnd, WM_USER + 3, 3, 0 );
+    PostThreadMessageA( GetCurrentThreadId(), WM_USER + 4, 4, 0 );
+
+    for (i = 1; i <= 4; i++)
+    {
+        ret = PeekMessageA( &msg, 0, WM_USER + 1, WM_USER + 4, PM_REMOVE );
+        ok( ret, "%d: PeekMessage failed\n", i );
+        ok( msg.message == WM_USER + i, "%d: got message %#x\n", i, msg.message );
+        ok( msg.wParam == i, "%d: got wparam %Iu\n", i, msg.wParam );
+        ok( msg.hwnd == (i == 4 ? 0 : hwnd), "%d: got hwnd %p\n", i, msg.hwnd );
+    }
+
+    DestroyWindow( hwnd );
+    flush_events();
+}
+
 static WPARAM g_broadcast_wparam;
 static UINT g_broadcast_msg;
 static LRESULT WINAPI broadcast_test_proc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
@@ -20265,6 +20328,7 @@ START_TEST(msg)
     test_SetFocus();
     test_SetParent();
     test_PostMessage();
+    test_PostMessage_order();
     test_broadcast();
     test_ShowWindow();
     test_PeekMessage();
@@ -23,6 +23,9 @@
 #endif
 
 #include <assert.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "ntgdi_private.h"
 #include "dibdrv.h"
@@ -4682,6 +4685,68 @@ static inline DWORD blend_rgb( BYTE dst_r, BYTE dst_g, BYTE dst_b, DWORD src, BL
             blend_color( dst_r, src >> 16, blend.SourceConstantAlpha ) << 16);
 }
 
+#if defined(__SSE2__)
+
+/* Computes (x + 127) / 255 for each 16-bit lane, with x <= 255 * 255. */
+static inline __m128i div255_epu16( __m128i x )
+{
+    x = _mm_add_epi16( x, _mm_set1_epi16( 128 ) );
+    return _mm_srli_epi16( _mm_add_epi16( x, _mm_srli_epi16( x, 8 ) ), 8 );
+}
+
+static inline __m128i blend_argb_epu16( __m128i dst, __m128i src )
+{
+    __m128i alpha = _mm_shufflehi_epi16( _mm_shufflelo_epi16( src, 0xff ), 0xff );
+
+    alpha = _mm_sub_epi16( _mm_set1_epi16( 255 ), alpha );
+    return _mm_add_epi16( src, div255_epu16( _mm_mullo_epi16( dst, alpha ) ));
+}
+
+/* Blends four pixels at a time, returns the number of pixels processed. */
+static int blend_argb_sse2( DWORD *dst, const DWORD *src, int len )
+{
+    const __m128i zero = _mm_setzero_si128(), mask = _mm_set1_epi16( 0xff );
+    int x;
+
+    for (x = 0; x + 4 <= len; x += 4)
+    {
+        __m128i s = _mm_loadu_si128( (const __m128i *)(src + x) );
+        __m128i d = _mm_loadu_si128( (const __m128i *)(dst + x) );
+        __m128i lo = blend_argb_epu16( _mm_unpacklo_epi8( d, zero ), _mm_unpacklo_epi8( s, zero ));
+        __m128i hi = blend_argb_epu16( _mm_unpackhi_epi8( d, zero ), _mm_unpackhi_epi8( s, zero ));
+        __m128i low_bits, carry_bits;
+
+        /* blend_argb() doesn't saturate; channels overflowing 255 carry
+         * into the next channel, so do the same here. */
+        low_bits = _mm_packus_epi16( _mm_and_si128( lo, mask ), _mm_and_si128( hi, mask ));
+        carry_bits = _mm_packus_epi16( _mm_srli_epi16( lo, 8 ), _mm_srli_epi16( hi, 8 ));
+        _mm_storeu_si128( (__m128i *)(dst + x), _mm_or_si128( low_bits, _mm_slli_epi32( carry_bits, 8 )));
+    }
+    return x;
+}
+
+static int blend_argb_constant_alpha_sse2( DWORD *dst, const DWORD *src, int len, DWORD alpha )
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_alpha = _mm_set1_epi16( alpha ), dst_alpha = _mm_set1_epi16( 255 - alpha );
+    int x;
+
+    for (x = 0; x + 4 <= len; x += 4)
+    {
+        __m128i s = _mm_loadu_si128( (const __m128i *)(src + x) );
+        __m128i d = _mm_loadu_si128( (const __m128i *)(dst + x) );
+        __m128i lo = _mm_add_epi16( _mm_mullo_epi16( _mm_unpacklo_epi8( s, zero ), src_alpha ),
+                                    _mm_mullo_epi16( _mm_unpacklo_epi8( d, zero ), dst_alpha ));
+        __m128i hi = _mm_add_epi16( _mm_mullo_epi16( _mm_unpackhi_epi8( s, zero ), src_alpha ),
+                                    _mm_mullo_epi16( _mm_unpackhi_epi8( d, zero ), dst_alpha ));
+
+        _mm_storeu_si128( (__m128i *)(dst + x), _mm_packus_epi16( div255_epu16( lo ), div255_epu16( hi )));
+    }
+    return x;
+}
+
+#endif /* __SSE2__ */
+
 static void blend_rects_8888(const dib_info *dst, int num, const RECT *rc,
                              const dib_info *src, const POINT *offset, BLENDFUNCTION blend)
 {
@@ -4696,8 +4761,14 @@ static void blend_rects_8888(const dib_info *dst, int num, const RECT *rc,
         {
             if (blend.SourceConstantAlpha == 255)
                 for (y = rc->top; y < rc->bottom; y++, dst_ptr += dst->stride / 4, src_ptr += src->stride / 4)
-                    for (x = 0; x < rc->right - rc->left; x++)
+                {
+                    x = 0;
+#if defined(__SSE2__)
+                    x = blend_argb_sse2( dst_ptr, src_ptr, rc->right - rc->left );
+#endif
+                    for (; x < rc->right - rc->left; x++)
                         dst_ptr[x] = blend_argb( dst_ptr[x], src_ptr[x] );
+                }
             else
                 for (y = rc->top; y < rc->bottom; y++, dst_ptr += dst->stride / 4, src_ptr += src->stride / 4)
                     for (x = 0; x < rc->right - rc->left; x++)
@@ -4705,8 +4776,15 @@ static void blend_rects_8888(const dib_info *dst, int num, const RECT *rc,
         }
         else if (src->compression == BI_RGB)
             for (y = rc->top; y < rc->bottom; y++, dst_ptr += dst->stride / 4, src_ptr += src->stride / 4)
-                for (x = 0; x < rc->right - rc->left; x++)
+            {
+                x = 0;
+#if defined(__SSE2__)
+                x = blend_argb_constant_alpha_sse2( dst_ptr, src_ptr, rc->right - rc->left,
+                                                    blend.SourceConstantAlpha );
+#endif
+                for (; x < rc->right - rc->left; x++)
                     dst_ptr[x] = blend_argb_constant_alpha( dst_ptr[x], src_ptr[x], blend.SourceConstantAlpha );
+            }
         else
             for (y = rc->top; y < rc->bottom; y++, dst_ptr += dst->stride / 4, src_ptr += src->stride / 4)
                 for (x = 0; x < rc->right - rc->left; x++)
@@ -49,6 +49,7 @@ WINE_DEFAULT_DEBUG_CHANNEL(font);
 
 static HKEY wine_fonts_key;
 static HKEY wine_fonts_cache_key;
+static BOOL building_font_cache;  /* this process is recording the system fonts in the cache */
 HKEY hkcu_key;
 
 struct font_physdev
@@ -1347,6 +1348,11 @@ static void add_face_to_cache( struct gdi_font_face *face )
     DWORD len, buffer[1024];
     struct cached_face *cached = (struct cached_face *)buffer;
 
+    if (!wine_fonts_cache_key || !face->file) return;
+    if (!(face->flags & ADDFONT_ADD_RESOURCE) && !building_font_cache) return;
+    len = lstrlenW( face->full_name ) + lstrlenW( face->file ) + 2;
+    if (offsetof( struct cached_face, full_name[len] ) > sizeof(buffer)) return;
+
     if (!(hkey_family = reg_create_key( wine_fonts_cache_key, face->family->family_name,
                                         lstrlenW( face->family->family_name ) * sizeof(WCHAR),
                                         REG_OPTION_VOLATILE, NULL )))
@@ -1391,6 +1397,9 @@ static void remove_face_from_cache( struct gdi_font_face *face )
 {
     HKEY hkey_family, hkey;
 
+    /* the system fonts are shared by the whole session */
+    if (!(face->flags & ADDFONT_ADD_RESOURCE) && !building_font_cache) return;
+
     if (!(hkey_family = reg_open_key( wine_fonts_cache_key, face->family->family_name,
                                       lstrlenW( face->family->family_name ) * sizeof(WCHAR) )))
         return;
@@ -6533,7 +6542,7 @@ static void load_system_bitmap_fonts(void)
     for (i = 0; i < ARRAY_SIZE(fonts); i++)
     {
         if (query_reg_ascii_value( hkey, fonts[i], info, sizeof(value_buffer) ) && info->Type == REG_SZ)
-            add_system_font_resource( (const WCHAR *)info->Data, ADDFONT_ALLOW_BITMAP );
+            add_system_font_resource( (const WCHAR *)info->Data, ADDFONT_ALLOW_BITMAP | ADDFONT_ADD_TO_CACHE );
     }
     NtClose( hkey );
 }
@@ -6588,7 +6597,8 @@ static void load_directory_fonts( WCHAR *path, UINT flags )
     NtClose( handle );
 }
 
-static void load_file_system_fonts(void)
+static void enum_file_system_font_dirs( void (*func)( WCHAR *path, UINT flags, void *context ),
+                                        void *context )
 {
     char value_buffer[FIELD_OFFSET(KEY_VALUE_PARTIAL_INFORMATION, Data[1024 * sizeof(WCHAR)])];
     KEY_VALUE_PARTIAL_INFORMATION *info = (void *)value_buffer;
@@ -6596,11 +6606,11 @@ static void load_file_system_fonts(void)
 
     /* Windows directory */
     get_fonts_win_dir_path( NULL, path );
-    load_directory_fonts( path, 0 );
+    func( path, ADDFONT_ADD_TO_CACHE, context );
 
     /* Wine data directory */
     get_fonts_data_dir_path( NULL, path );
-    load_directory_fonts( path, ADDFONT_EXTERNAL_FONT );
+    func( path, ADDFONT_EXTERNAL_FONT | ADDFONT_ADD_TO_CACHE, context );
 
     /* custom paths */
     /* @@ Wine registry key: HKCU\Software\Wine\Fonts */
@@ -6617,11 +6627,50 @@ static void load_file_system_fonts(void)
                 memmove( path + ARRAYSIZE(nt_prefixW), path, (lstrlenW( path ) + 1) * sizeof(WCHAR) );
                 memcpy( path, nt_prefixW, sizeof(nt_prefixW) );
             }
-            load_directory_fonts( path, ADDFONT_EXTERNAL_FONT );
+            func( path, ADDFONT_EXTERNAL_FONT | ADDFONT_ADD_TO_CACHE, context );
         }
     }
 }
 
+static void load_font_dir( WCHAR *path, UINT flags, void *context )
+{
+    load_directory_fonts( path, flags );
+}
+
+static void add_font_dir_stamp( WCHAR *path, UINT flags, void *context )
+{
+    FILE_NETWORK_OPEN_INFORMATION info;
+    ULONGLONG *stamp = context;
+    UNICODE_STRING nt_name;
+    OBJECT_ATTRIBUTES attr;
+    size_t len;
+
+    len = lstrlenW( path );
+    while (len && path[len - 1] == '\\') len--;
+
+    nt_name.Buffer = path;
+    nt_name.MaximumLength = nt_name.Length = len * sizeof(WCHAR);
+
+    attr.Length = sizeof(attr);
+    attr.RootDirectory = 0;
+    attr.Attributes = OBJ_CASE_INSENSITIVE;
+    attr.ObjectName = &nt_name;
+    attr.SecurityDescriptor = NULL;
+    attr.SecurityQualityOfService = NULL;
+
+    if (!NtQueryFullAttributesFile( &attr, &info ))
+        *stamp = *stamp * 31 + info.LastWriteTime.QuadPart;
+}
+
+/* Combine the modification times of the system font directories; the font
+ * cache is rebuilt when it doesn't match the value it was created with. */
+static ULONGLONG get_system_fonts_stamp(void)
+{
+    ULONGLONG stamp = font_funcs->get_fonts_stamp();
+    enum_file_system_font_dirs( add_font_dir_stamp, &stamp );
+    return stamp;
+}
+
 struct external_key
 {
     struct list entry;
@@ -6715,6 +6764,13 @@ static void update_external_font_keys(void)
     NtClose( hkey );
 }
 
+static void load_system_fonts(void)
+{
+    load_system_bitmap_fonts();
+    enum_file_system_font_dirs( load_font_dir, NULL );
+    font_funcs->load_fonts();
+}
+
 static void load_registry_fonts(void)
 {
     char value_buffer[FIELD_OFFSET(KEY_VALUE_PARTIAL_INFORMATION, Data[MAX_PATH * sizeof(WCHAR)])];
@@ -6794,8 +6850,11 @@ static HKEY open_hkcu(void)
  */
 UINT font_init(void)
 {
+    char value_buffer[FIELD_OFFSET(KEY_VALUE_PARTIAL_INFORMATION, Data[sizeof(ULONGLONG)])];
+    KEY_VALUE_PARTIAL_INFORMATION *info = (void *)value_buffer;
     OBJECT_ATTRIBUTES attr = { sizeof(attr) };
     UNICODE_STRING name;
+    ULONGLONG stamp;
     HANDLE mutex;
     DWORD disposition;
     UINT dpi = 0;
@@ -6806,6 +6865,7 @@ UINT font_init(void)
     static const WCHAR wine_fonts_keyW[] =
         {'S','o','f','t','w','a','r','e','\\','W','i','n','e','\\','F','o','n','t','s'};
     static const WCHAR cacheW[] = {'C','a','c','h','e'};
+    static const WCHAR stampW[] = {'S','t','a','m','p',0};
 
     if (!(hkcu_key = open_hkcu())) return 0;
     wine_fonts_key = reg_create_key( hkcu_key, wine_fonts_keyW, sizeof(wine_fonts_keyW), 0, NULL );
@@ -6816,33 +6876,55 @@ UINT font_init(void)
     if (!(font_funcs = init_freetype_lib()))
         return dpi;
 
-    load_system_bitmap_fonts();
-    load_file_system_fonts();
-    font_funcs->load_fonts();
-
     attr.Attributes = OBJ_OPENIF;
     attr.ObjectName = &name;
     name.Buffer = wine_font_mutexW;
     name.Length = name.MaximumLength = sizeof(wine_font_mutexW);
 
-    if (NtCreateMutant( &mutex, MUTEX_ALL_ACCESS, &attr, FALSE ) < 0) return dpi;
+    if (NtCreateMutant( &mutex, MUTEX_ALL_ACCESS, &attr, FALSE ) < 0)
+    {
+        load_system_fonts();
+        return dpi;
+    }
+    stamp = get_system_fonts_stamp();
     NtWaitForSingleObject( mutex, FALSE, NULL );
 
-    wine_fonts_cache_key = reg_create_key( wine_fonts_key, cacheW, sizeof(cacheW),
-                                           REG_OPTION_VOLATILE, &disposition );
+    if ((wine_fonts_cache_key = reg_create_key( wine_fonts_key, cacheW, sizeof(cacheW),
+                                                REG_OPTION_VOLATILE, &disposition )) &&
+        disposition != REG_CREATED_NEW_KEY &&
+        (query_reg_value( wine_fonts_cache_key, stampW, info, sizeof(value_buffer) ) != sizeof(stamp) ||
+         memcmp( info->Data, &stamp, sizeof(stamp) )))
+    {
+        TRACE( "font directories changed, rebuilding the font cache\n" );
+        NtClose( wine_fonts_cache_key );
+        reg_delete_tree( wine_fonts_key, cacheW, sizeof(cacheW) );
+        wine_fonts_cache_key = reg_create_key( wine_fonts_key, cacheW, sizeof(cacheW),
+                                               REG_OPTION_VOLATILE, &disposition );
+    }
+    if (!wine_fonts_cache_key) disposition = REG_CREATED_NEW_KEY;
 
+    /* The first process in the session scans the system fonts and records
+     * them in the volatile cache key; later processes load the face list
+     * from there instead of opening every font file again. */
     if (disposition == REG_CREATED_NEW_KEY)
     {
+        building_font_cache = TRUE;
+        load_system_fonts();
         load_registry_fonts();
         update_external_font_keys();
+        building_font_cache = FALSE;
+        if (wine_fonts_cache_key)
+            set_reg_value( wine_fonts_cache_key, stampW, REG_BINARY, &stamp, sizeof(stamp) );
     }
 
     NtReleaseMutant( mutex, NULL );
 
     if (disposition != REG_CREATED_NEW_KEY)
     {
-        load_registry_fonts();
+        /* load the cache first, so that the registry fonts found there
+         * are skipped instead of being opened again */
         load_font_list_from_cache();
+        load_registry_fonts();
     }
 
     reorder_font_list();
@@ -1487,7 +1487,7 @@ static BOOL ReadFontDir(const char *dirname, BOOL external_fonts)
 	    ReadFontDir(path, external_fonts);
 	else
         {
-            DWORD addfont_flags = 0;
+            DWORD addfont_flags = ADDFONT_ADD_TO_CACHE;
             if(external_fonts) addfont_flags |= ADDFONT_EXTERNAL_FONT;
             AddFontToList(NULL, path, NULL, 0, addfont_flags);
         }
@@ -1706,7 +1706,8 @@ static void load_fontconfig_fonts( void )
     if (!(done_set = pFcStrSetCreate())) goto done;
     if (!(dir_list = pFcConfigGetFontDirs( config ))) goto done;
 
-    fontconfig_add_fonts_from_dir_list( config, dir_list, done_set, ADDFONT_EXTERNAL_FONT );
+    fontconfig_add_fonts_from_dir_list( config, dir_list, done_set,
+                                        ADDFONT_EXTERNAL_FONT | ADDFONT_ADD_TO_CACHE );
 
 done:
     if (dir_list) pFcStrListDone( dir_list );
@@ -1726,7 +1727,7 @@ static void load_mac_font_callback(const void *value, void *context)
     if (path && CFStringGetFileSystemRepresentation(pathStr, path, len))
     {
         TRACE("font file %s\n", path);
-        AddFontToList(NULL, path, NULL, 0, ADDFONT_EXTERNAL_FONT);
+        AddFontToList(NULL, path, NULL, 0, ADDFONT_EXTERNAL_FONT | ADDFONT_ADD_TO_CACHE);
     }
     free( path );
 }
@@ -1914,6 +1915,45 @@ static void freetype_load_fonts(void)
 #endif
 }
 
+#if defined(SONAME_LIBFONTCONFIG) || defined(__APPLE__) || defined(__ANDROID__)
+static void add_font_dir_stamp( const char *dirname, ULONGLONG *stamp )
+{
+    struct stat st;
+
+    if (!stat( dirname, &st )) *stamp = *stamp * 31 + st.st_mtime;
+}
+#endif
+
+/*************************************************************
+ * freetype_get_fonts_stamp
+ *
+ * Combine the modification times of the top-level directories scanned by
+ * freetype_load_fonts, so that the font cache can be rebuilt when fonts
+ * are installed or removed. Subdirectories are not checked, to keep this
+ * cheap at every process startup.
+ */
+static ULONGLONG freetype_get_fonts_stamp(void)
+{
+    ULONGLONG stamp = 0;
+#ifdef SONAME_LIBFONTCONFIG
+    FcStrList *dir_list;
+    FcConfig *config;
+    FcChar8 *dir;
+
+    if (!fontconfig_enabled) return 0;
+    if (!(config = pFcConfigGetCurrent())) return 0;
+    if (!(dir_list = pFcConfigGetFontDirs( config ))) return 0;
+    while ((dir = pFcStrListNext( dir_list ))) add_font_dir_stamp( (const char *)dir, &stamp );
+    pFcStrListDone( dir_list );
+#elif defined(__APPLE__)
+    add_font_dir_stamp( "/Library/Fonts", &stamp );
+    add_font_dir_stamp( "/System/Library/Fonts", &stamp );
+#elif defined(__ANDROID__)
+    add_font_dir_stamp( "/system/fonts", &stamp );
+#endif
+    return stamp;
+}
+
 /* Some fonts have large usWinDescent values, as a result of storing signed short
    in unsigned field. That's probably caused by sTypoDescent vs usWinDescent confusion in
    some font generation tools. */
@@ -4266,6 +4306,7 @@ static UINT freetype_get_kerning_pairs( struct gdi_font *font, KERNINGPAIR **pai
 static const struct font_backend_funcs font_funcs =
 {
     freetype_load_fonts,
+    freetype_get_fonts_stamp,
     fontconfig_enum_family_fallbacks,
     freetype_add_font,
     freetype_add_mem_font,
@@ -833,6 +833,7 @@ SHORT WINAPI NtUserGetAsyncKeyState( INT key )
  */
 DWORD WINAPI NtUserGetQueueStatus( UINT flags )
 {
+    UINT wake_bits, changed_bits;
     DWORD ret;
 
     if (flags & ~(QS_ALLINPUT | QS_ALLPOSTMESSAGE | QS_SMRESULT))
@@ -842,12 +843,13 @@ DWORD WINAPI NtUserGetQueueStatus( UINT flags )
     }
 
     check_for_events( flags );
+    get_local_queue_bits( flags, &wake_bits, &changed_bits );
 
     SERVER_START_REQ( get_queue_status )
     {
         req->clear_bits = flags;
         wine_server_call( req );
-        ret = MAKELONG( reply->changed_bits & flags, reply->wake_bits & flags );
+        ret = MAKELONG( (reply->changed_bits | changed_bits) & flags, (reply->wake_bits | wake_bits) & flags );
     }
     SERVER_END_REQ;
     return ret;
@@ -287,6 +287,19 @@ struct send_message_info
     struct win_proc_params *params;
 };
 
+/* Messages that a thread posts to itself are kept in a client side ring and never reach the
+ * server. This is only done while the server queue has no posted messages, so that those
+ * are always older than the local ones and ordering is preserved. */
+#define LOCAL_POST_QUEUE_SIZE 64
+
+struct local_post_queue
+{
+    unsigned int head;     /* index of the oldest message */
+    unsigned int count;    /* number of queued messages */
+    BOOL         changed;  /* messages have been posted since the last queue status check */
+    MSG          msgs[LOCAL_POST_QUEUE_SIZE];
+};
+
 static const INPUT_MESSAGE_SOURCE msg_source_unavailable = { IMDT_UNAVAILABLE, IMO_UNAVAILABLE };
 static BOOL keyboard_auto_repeat_enabled;
 
@@ -2787,6 +2800,152 @@ static BOOL process_hardware_message( MSG *msg, UINT hw_id, const struct hardwar
     return ret;
 }
 
+static int peek_message( MSG *msg, HWND hwnd, UINT first, UINT last, UINT flags, UINT changed_mask, BOOL waited );
+
+/***********************************************************************
+ *           post_local_message
+ *
+ * Post a message to the current thread without going through the server, if possible.
+ */
+static BOOL post_local_message( HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam )
+{
+    struct user_thread_info *thread_info = get_user_thread_info();
+    struct local_post_queue *queue = thread_info->post_queue;
+    const queue_shm_t *shared = get_queue_shared_memory();
+    const desktop_shm_t *desktop;
+    UINT wake_bits = 0;
+    BOOL created = FALSE;
+    MSG *entry;
+
+    if (msg & 0x80000000) return FALSE;  /* internal messages */
+    if (msg >= WM_DDE_FIRST && msg <= WM_DDE_LAST) return FALSE;
+    if (msg == WM_HOTKEY) return FALSE;  /* needs QS_HOTKEY */
+    if (!shared) return FALSE;
+
+    SHARED_READ_BEGIN( shared, queue_shm_t )
+    {
+        created = shared->created;
+        wake_bits = shared->wake_bits;
+    }
+    SHARED_READ_END
+
+    /* the server queue may contain older posted messages, or a pending WM_QUIT */
+    if (!created || (wake_bits & (QS_POSTMESSAGE | QS_ALLPOSTMESSAGE))) return FALSE;
+
+    if (!queue && !(queue = thread_info->post_queue = calloc( 1, sizeof(*queue) ))) return FALSE;
+    if (queue->count == LOCAL_POST_QUEUE_SIZE) return FALSE;
+
+    entry = &queue->msgs[(queue->head + queue->count) % LOCAL_POST_QUEUE_SIZE];
+    entry->hwnd    = hwnd;
+    entry->message = msg;
+    entry->wParam  = wparam;
+    entry->lParam  = lparam;
+    entry->time    = NtGetTickCount();
+    entry->pt.x    = entry->pt.y = 0;
+    if ((desktop = get_desktop_shared_memory()))
+    {
+        SHARED_READ_BEGIN( desktop, desktop_shm_t )
+        {
+            entry->pt.x = desktop->cursor.x;
+            entry->pt.y = desktop->cursor.y;
+        }
+        SHARED_READ_END
+    }
+    queue->count++;
+    queue->changed = TRUE;
+    return TRUE;
+}
+
+static void remove_local_message( struct local_post_queue *queue, unsigned int index )
+{
+    unsigned int i;
+
+    /* move the older messages up, so the ring stays contiguous */
+    for (i = index; i > 0; i--)
+        queue->msgs[(queue->head + i) % LOCAL_POST_QUEUE_SIZE] =
+            queue->msgs[(queue->head + i - 1) % LOCAL_POST_QUEUE_SIZE];
+    queue->head = (queue->head + 1) % LOCAL_POST_QUEUE_SIZE;
+    queue->count--;
+}
+
+/* same filtering as the server get_message request */
+static BOOL match_local_message( const MSG *msg, HWND hwnd, UINT first, UINT last )
+{
+    if (msg->message < first || msg->message > last) return FALSE;
+    if (!hwnd) return TRUE;
+    if (hwnd == (HWND)-1 || hwnd == (HWND)1) return !msg->hwnd;
+    return msg->hwnd == hwnd || is_child( hwnd, msg->hwnd );
+}
+
+/***********************************************************************
+ *           peek_local_message
+ *
+ * Retrieve a message that the current thread posted to itself.
+ */
+static BOOL peek_local_message( MSG *msg, HWND hwnd, UINT first, UINT last, UINT flags )
+{
+    struct user_thread_info *thread_info = get_user_thread_info();
+    struct local_post_queue *queue = thread_info->post_queue;
+    const queue_shm_t *shared = get_queue_shared_memory();
+    unsigned int i = 0;
+    UINT wake_bits = 0;
+    MSG *entry;
+
+    if (!queue) return FALSE;
+    /* the messages have been seen, like the server get_message clearing the changed bits */
+    queue->changed = FALSE;
+    if (!queue->count) return FALSE;
+
+    /* sent messages have to be processed before posted ones */
+    if (shared)
+    {
+        SHARED_READ_BEGIN( shared, queue_shm_t )
+        {
+            wake_bits = shared->wake_bits;
+        }
+        SHARED_READ_END
+    }
+    /* the server also needs a get_message call from time to time, or it would */
+    /* consider the queue hung; this updates last_getmsg_time as well */
+    if ((wake_bits & QS_SENDMESSAGE) || NtGetTickCount() - thread_info->last_getmsg_time >= 3000)
+    {
+        MSG sent;
+        peek_message( &sent, 0, 0, 0, PM_REMOVE | PM_QS_SENDMESSAGE, 0, FALSE );
+    }
+
+    if (hwnd && hwnd != (HWND)-1 && hwnd != (HWND)1) hwnd = get_full_window_handle( hwnd );
+
+    while (i < queue->count)
+    {
+        entry = &queue->msgs[(queue->head + i) % LOCAL_POST_QUEUE_SIZE];
+        /* the server drops messages of destroyed windows */
+        if (entry->hwnd && !is_window( entry->hwnd )) remove_local_message( queue, i );
+        else if (match_local_message( entry, hwnd, first, last )) break;
+        else i++;
+    }
+    if (i == queue->count) return FALSE;
+
+    *msg = queue->msgs[(queue->head + i) % LOCAL_POST_QUEUE_SIZE];
+    if (flags & PM_REMOVE) remove_local_message( queue, i );
+    return TRUE;
+}
+
+/***********************************************************************
+ *           get_local_queue_bits
+ *
+ * Get the queue bits for messages posted by the thread to itself.
+ */
+void get_local_queue_bits( UINT clear_bits, UINT *wake_bits, UINT *changed_bits )
+{
+    struct local_post_queue *queue = get_user_thread_info()->post_queue;
+
+    *wake_bits = *changed_bits = 0;
+    if (!queue || !queue->count) return;
+    *wake_bits = QS_POSTMESSAGE | QS_ALLPOSTMESSAGE;
+    if (queue->changed) *changed_bits = QS_POSTMESSAGE | QS_ALLPOSTMESSAGE;
+    if (clear_bits & QS_POSTMESSAGE) queue->changed = FALSE;
+}
+
 /***********************************************************************
  *           peek_message
  *
@@ -2849,7 +3008,12 @@ static int peek_message( MSG *msg, HWND hwnd, UINT first, UINT last, UINT flags,
         }
         SHARED_READ_END
 
-        if (skip) res = STATUS_PENDING;
+        if ((filter & QS_POSTMESSAGE) && peek_local_message( &info.msg, hwnd, first, last, flags ))
+        {
+            info.type = MSG_POSTED;
+            res = STATUS_SUCCESS;
+        }
+        else if (skip) res = STATUS_PENDING;
         else SERVER_START_REQ( get_message )
         {
             req->flags     = flags;
@@ -3261,6 +3425,7 @@ DWORD WINAPI NtUserMsgWaitForMultipleObjectsEx( DWORD count, const HANDLE *handl
                                                 DWORD timeout, DWORD mask, DWORD flags )
 {
     HANDLE wait_handles[MAXIMUM_WAIT_OBJECTS];
+    UINT wake_bits, changed_bits;
     DWORD i;
 
     if (count > MAXIMUM_WAIT_OBJECTS-1)
@@ -3269,6 +3434,10 @@ DWORD WINAPI NtUserMsgWaitForMultipleObjectsEx( DWORD count, const HANDLE *handl
         return WAIT_FAILED;
     }
 
+    /* the server doesn't know about the messages we posted to ourselves */
+    get_local_queue_bits( 0, &wake_bits, &changed_bits );
+    if ((changed_bits & mask) || ((flags & MWMO_INPUTAVAILABLE) && (wake_bits & mask))) return count;
+
     /* add the queue to the handle list */
     for (i = 0; i < count; i++) wait_handles[i] = normalize_std_handle( handles[i] );
     wait_handles[count] = get_server_queue_handle();
@@ -4458,6 +4627,10 @@ BOOL WINAPI NtUserPostMessage( HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam
 
     if (is_exiting_thread( info.dest_tid )) return TRUE;
 
+    if (info.dest_tid == GetCurrentThreadId() &&
+        post_local_message( get_full_window_handle( hwnd ), msg, wparam, lparam ))
+        return TRUE;
+
     return put_message_in_queue( &info, NULL );
 }
 
@@ -4474,6 +4647,7 @@ BOOL WINAPI NtUserPostThreadMessage( DWORD thread, UINT msg, WPARAM wparam, LPAR
         return FALSE;
     }
     if (is_exiting_thread( thread )) return TRUE;
+    if (thread == GetCurrentThreadId() && post_local_message( 0, msg, wparam, lparam )) return TRUE;
 
     info.type     = MSG_POSTED;
     info.dest_tid = thread;
@@ -149,9 +149,11 @@ struct user_thread_info
     BOOL                          clipping_cursor;        /* thread is currently clipping */
     DWORD                         clipping_reset;         /* time when clipping was last reset */
     const desktop_shm_t          *desktop_shm;            /* Ptr to server's desktop shared memory */
+    const window_shm_t           *windows_shm;            /* Ptr to server's desktop windows shared memory */
     const queue_shm_t            *queue_shm;              /* Ptr to server's thread queue shared memory */
     const input_shm_t            *input_shm;              /* Ptr to server's thread input shared memory */
     const input_shm_t            *foreground_shm;         /* Ptr to server's foreground thread input shared memory */
+    struct local_post_queue      *post_queue;             /* Messages posted by the thread to itself */
 };
 
 C_ASSERT( sizeof(struct user_thread_info) <= sizeof(((TEB *)0)->Win32ClientInfo) );
@@ -280,6 +282,7 @@ extern const desktop_shm_t *get_desktop_shared_memory(void);
 extern const queue_shm_t *get_queue_shared_memory(void);
 extern const input_shm_t *get_input_shared_memory(void);
 extern const input_shm_t *get_foreground_shared_memory(void);
+extern const window_shm_t *get_window_shared_memory( HWND hwnd );
 
 static inline UINT win_get_flags( HWND hwnd )
 {
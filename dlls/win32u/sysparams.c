@@ -6237,6 +6237,7 @@ static void thread_detach(void)
     user_driver->pThreadDetach();
 
     free( thread_info->rawinput );
+    free( thread_info->post_queue );
 
     destroy_thread_windows();
     cleanup_imm_thread();
@@ -6248,6 +6249,12 @@ static void thread_detach(void)
         thread_info->desktop_shm = NULL;
     }
 
+    if (thread_info->windows_shm)
+    {
+        NtUnmapViewOfSection( GetCurrentProcess(), (void *)thread_info->windows_shm );
+        thread_info->windows_shm = NULL;
+    }
+
     if (thread_info->queue_shm)
     {
         NtUnmapViewOfSection( GetCurrentProcess(), (void *)thread_info->queue_shm );
@@ -175,6 +175,29 @@ HWND get_hwnd_message_parent(void)
     return UlongToHandle( thread_info->msg_window );
 }
 
+/*******************************************************************
+ *           get_window_shared_info
+ *
+ * Read the server window state from the shared memory, without a server call.
+ * Return FALSE if the handle doesn't match any window.
+ */
+static BOOL get_window_shared_info( HWND hwnd, struct window_shared_memory *info )
+{
+    const window_shm_t *shared = get_window_shared_memory( hwnd );
+    UINT handle = wine_server_user_handle( hwnd );
+
+    if (!shared) return FALSE;
+    SHARED_READ_BEGIN( shared, window_shm_t )
+    {
+        *info = *shared;
+    }
+    SHARED_READ_END
+
+    if (!info->handle) return FALSE;
+    if (HIWORD(handle) && HIWORD(handle) != 0xffff) return info->handle == handle;
+    return LOWORD(info->handle) == LOWORD(handle);
+}
+
 /***********************************************************************
  *           get_full_window_handle
  *
@@ -204,6 +227,10 @@ HWND get_full_window_handle( HWND hwnd )
     }
     else  /* may belong to another process */
     {
+        struct window_shared_memory info;
+
+        if (get_window_shared_info( hwnd, &info )) return wine_server_ptr_handle( info.handle );
+
         SERVER_START_REQ( get_window_info )
         {
             req->handle = wine_server_user_handle( hwnd );
@@ -289,6 +316,7 @@ HWND is_current_process_window( HWND hwnd )
 /* see IsWindow */
 BOOL is_window( HWND hwnd )
 {
+    struct window_shared_memory info;
     WND *win;
     BOOL ret;
 
@@ -301,6 +329,8 @@ BOOL is_window( HWND hwnd )
         return TRUE;
     }
 
+    if (get_window_shared_info( hwnd, &info )) return TRUE;
+
     /* check other processes */
     SERVER_START_REQ( get_window_info )
     {
@@ -314,6 +344,7 @@ BOOL is_window( HWND hwnd )
 /* see GetWindowThreadProcessId */
 DWORD get_window_thread( HWND hwnd, DWORD *process )
 {
+    struct window_shared_memory info;
     WND *ptr;
     DWORD tid = 0;
 
@@ -332,6 +363,12 @@ DWORD get_window_thread( HWND hwnd, DWORD *process )
         return tid;
     }
 
+    if (ptr == WND_OTHER_PROCESS && get_window_shared_info( hwnd, &info ))
+    {
+        if (process) *process = info.pid;
+        return info.tid;
+    }
+
     /* check other processes */
     SERVER_START_REQ( get_window_info )
     {
@@ -360,7 +397,17 @@ HWND get_parent( HWND hwnd )
     if (win == WND_DESKTOP) return 0;
     if (win == WND_OTHER_PROCESS)
     {
-        LONG style = get_window_long( hwnd, GWL_STYLE );
+        struct window_shared_memory info;
+        LONG style;
+
+        if (get_window_shared_info( hwnd, &info ))
+        {
+            if (info.style & WS_POPUP) retval = wine_server_ptr_handle( info.owner );
+            else if (info.style & WS_CHILD) retval = wine_server_ptr_handle( info.parent );
+            return retval;
+        }
+
+        style = get_window_long( hwnd, GWL_STYLE );
         if (style & (WS_POPUP | WS_CHILD))
         {
             SERVER_START_REQ( get_window_tree )
@@ -689,6 +736,7 @@ static BOOL enum_child_windows( HWND parent, WNDENUMPROC func, LPARAM lParam )
  */
 HWND WINAPI NtUserGetAncestor( HWND hwnd, UINT type )
 {
+    struct window_shared_memory info;
     HWND *list, ret = 0;
     WND *win;
 
@@ -706,6 +754,10 @@ HWND WINAPI NtUserGetAncestor( HWND hwnd, UINT type )
             ret = win->parent;
             release_win_ptr( win );
         }
+        else if (get_window_shared_info( hwnd, &info ))
+        {
+            ret = wine_server_ptr_handle( info.parent );
+        }
         else /* need to query the server */
         {
             SERVER_START_REQ( get_window_tree )
@@ -767,6 +819,38 @@ BOOL is_child( HWND parent, HWND child )
     return ret;
 }
 
+/* check the window and parents visibility through the shared memory */
+static BOOL is_window_visible_shared( HWND hwnd, BOOL *visible )
+{
+    struct window_shared_memory info;
+    HWND parent;
+
+    if (!get_window_shared_info( hwnd, &info )) return FALSE;
+    if (!(info.style & WS_VISIBLE))
+    {
+        *visible = FALSE;
+        return TRUE;
+    }
+    if (!info.parent)
+    {
+        *visible = TRUE;
+        return TRUE;
+    }
+
+    while ((parent = wine_server_ptr_handle( info.parent )))
+    {
+        if (!get_window_shared_info( parent, &info )) return FALSE;
+        if (!info.parent) break;  /* top window, its visibility doesn't matter */
+        if (!(info.style & WS_VISIBLE))
+        {
+            *visible = FALSE;
+            return TRUE;
+        }
+    }
+    *visible = parent == get_desktop_window();  /* top message window isn't visible */
+    return TRUE;
+}
+
 /* see IsWindowVisible */
 BOOL is_window_visible( HWND hwnd )
 {
@@ -774,6 +858,10 @@ BOOL is_window_visible( HWND hwnd )
     BOOL retval = TRUE;
     int i;
 
+    if (!is_current_process_window( hwnd ) && !is_desktop_window( hwnd ) &&
+        is_window_visible_shared( hwnd, &retval ))
+        return retval;
+
     if (!(get_window_long( hwnd, GWL_STYLE ) & WS_VISIBLE)) return FALSE;
     if (!(list = list_window_parents( hwnd ))) return TRUE;
     if (list[0])
@@ -832,6 +920,10 @@ BOOL is_window_unicode( HWND hwnd )
     }
     else
     {
+        struct window_shared_memory info;
+
+        if (get_window_shared_info( hwnd, &info )) return info.is_unicode;
+
         SERVER_START_REQ( get_window_info )
         {
             req->handle = wine_server_user_handle( hwnd );
@@ -1045,11 +1137,24 @@ static LONG_PTR get_window_long_size( HWND hwnd, INT offset, UINT size, BOOL ans
 
     if (win == WND_OTHER_PROCESS)
     {
+        struct window_shared_memory info;
+
         if (offset == GWLP_WNDPROC)
         {
             RtlSetLastWin32Error( ERROR_ACCESS_DENIED );
             return 0;
         }
+        if (offset < 0 && get_window_shared_info( hwnd, &info ))
+        {
+            switch (offset)
+            {
+            case GWL_STYLE:      return info.style;
+            case GWL_EXSTYLE:    return info.ex_style;
+            case GWLP_ID:        return info.id;
+            case GWLP_HINSTANCE: return (ULONG_PTR)wine_server_get_ptr( info.instance );
+            case GWLP_USERDATA:  return info.user_data;
+            }
+        }
         SERVER_START_REQ( set_window_info )
         {
             req->handle = wine_server_user_handle( hwnd );
@@ -1588,6 +1693,69 @@ static void mirror_rect( const RECT *window_rect, RECT *rect )
     rect->right = width - tmp;
 }
 
+static RECT rect_from_shared( const rectangle_t *rect )
+{
+    RECT ret;
+    SetRect( &ret, rect->left, rect->top, rect->right, rect->bottom );
+    return ret;
+}
+
+/* get the window and client rectangles of another process window through the shared memory */
+static BOOL get_window_rects_shared( HWND hwnd, enum coords_relative relative, RECT *window_rect,
+                                     RECT *client_rect, UINT dpi )
+{
+    struct window_shared_memory info, parent;
+    RECT window, client, rect;
+    user_handle_t handle;
+
+    if (!get_window_shared_info( hwnd, &info )) return FALSE;
+    /* the server resolves a zero DPI to the monitor DPI before scaling, let it do the mapping */
+    if (info.dpi != dpi) return FALSE;
+    window = rect_from_shared( &info.window_rect );
+    client = rect_from_shared( &info.client_rect );
+
+    switch (relative)
+    {
+    case COORDS_CLIENT:
+        OffsetRect( &window, -info.client_rect.left, -info.client_rect.top );
+        OffsetRect( &client, -info.client_rect.left, -info.client_rect.top );
+        rect = rect_from_shared( &info.client_rect );
+        if (info.ex_style & WS_EX_LAYOUTRTL) mirror_rect( &rect, &window );
+        break;
+    case COORDS_WINDOW:
+        OffsetRect( &window, -info.window_rect.left, -info.window_rect.top );
+        OffsetRect( &client, -info.window_rect.left, -info.window_rect.top );
+        rect = rect_from_shared( &info.window_rect );
+        if (info.ex_style & WS_EX_LAYOUTRTL) mirror_rect( &rect, &client );
+        break;
+    case COORDS_PARENT:
+        if (!info.parent) break;
+        if (!get_window_shared_info( wine_server_ptr_handle( info.parent ), &parent )) return FALSE;
+        if (parent.ex_style & WS_EX_LAYOUTRTL)
+        {
+            rect = rect_from_shared( &parent.client_rect );
+            mirror_rect( &rect, &window );
+            mirror_rect( &rect, &client );
+        }
+        break;
+    case COORDS_SCREEN:
+        for (handle = info.parent; handle; handle = parent.parent)
+        {
+            if (!get_window_shared_info( wine_server_ptr_handle( handle ), &parent )) return FALSE;
+            if (!parent.parent) break;  /* desktop window */
+            OffsetRect( &window, parent.client_rect.left, parent.client_rect.top );
+            OffsetRect( &client, parent.client_rect.left, parent.client_rect.top );
+        }
+        break;
+    default:
+        return FALSE;
+    }
+
+    if (window_rect) *window_rect = window;
+    if (client_rect) *client_rect = client;
+    return TRUE;
+}
+
 /***********************************************************************
  *           get_window_rects
  *
@@ -1698,6 +1866,8 @@ BOOL get_window_rects( HWND hwnd, enum coords_relative relative, RECT *window_re
     }
 
 other_process:
+    if (get_window_rects_shared( hwnd, relative, window_rect, client_rect, dpi )) return TRUE;
+
     SERVER_START_REQ( get_window_rectangles )
     {
         req->handle = wine_server_user_handle( hwnd );
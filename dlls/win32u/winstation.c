@@ -273,6 +273,11 @@ BOOL WINAPI NtUserSetThreadDesktop( HDESK handle )
             NtUnmapViewOfSection( GetCurrentProcess(), (void *)thread_info->desktop_shm );
             thread_info->desktop_shm = NULL;
         }
+        if (thread_info->windows_shm)
+        {
+            NtUnmapViewOfSection( GetCurrentProcess(), (void *)thread_info->windows_shm );
+            thread_info->windows_shm = NULL;
+        }
     }
     return ret;
 }
@@ -710,31 +715,40 @@ volatile struct global_shared_memory *get_global_shared_memory( void )
     return ret;
 }
 
-const desktop_shm_t *get_desktop_shared_memory(void)
+/* build the path of a desktop mapping relative to the window stations directory */
+static void get_desktop_mapping_path( const WCHAR *dir, WCHAR *buf, DWORD size )
 {
-    static const WCHAR dir_desktop_maps[] =
-    {
-        '_','_','w','i','n','e','_','d','e','s','k','t','o','p','_','m','a','p','p','i','n','g','s','\\',0
-    };
-    struct user_thread_info *thread_info = get_user_thread_info();
-    HANDLE root, handles[2];
-    WCHAR buf[MAX_PATH], *ptr;
+    HANDLE handles[2];
+    WCHAR *ptr;
     DWORD i, needed;
 
-    if (thread_info->desktop_shm) return thread_info->desktop_shm;
-
     handles[0] = NtUserGetProcessWindowStation();
     handles[1] = NtUserGetThreadDesktop( GetCurrentThreadId() );
 
-    memcpy( buf, dir_desktop_maps, wcslen(dir_desktop_maps) * sizeof(WCHAR) );
-    ptr = buf + wcslen(dir_desktop_maps);
+    memcpy( buf, dir, wcslen(dir) * sizeof(WCHAR) );
+    ptr = buf + wcslen(dir);
 
     for (i = 0; i < 2; i++)
     {
-        NtUserGetObjectInformation( handles[i], UOI_NAME, (void *)ptr, sizeof(buf) - (ptr - buf) * sizeof(WCHAR), &needed );
+        NtUserGetObjectInformation( handles[i], UOI_NAME, (void *)ptr, size - (ptr - buf) * sizeof(WCHAR), &needed );
         ptr += needed / sizeof(WCHAR);
         if (i == 0) *(ptr - 1) = '\\';
     }
+}
+
+const desktop_shm_t *get_desktop_shared_memory(void)
+{
+    static const WCHAR dir_desktop_maps[] =
+    {
+        '_','_','w','i','n','e','_','d','e','s','k','t','o','p','_','m','a','p','p','i','n','g','s','\\',0
+    };
+    struct user_thread_info *thread_info = get_user_thread_info();
+    HANDLE root;
+    WCHAR buf[MAX_PATH];
+
+    if (thread_info->desktop_shm) return thread_info->desktop_shm;
+
+    get_desktop_mapping_path( dir_desktop_maps, buf, sizeof(buf) );
 
     root = get_winstations_dir_handle();
     thread_info->desktop_shm = map_shared_memory_section( buf, sizeof(*thread_info->desktop_shm), root );
@@ -806,6 +820,33 @@ const input_shm_t *get_foreground_shared_memory(void)
     return thread_info->foreground_shm;
 }
 
+/* the windows table only holds the windows of the thread desktop, other handles won't match */
+const window_shm_t *get_window_shared_memory( HWND hwnd )
+{
+    static const WCHAR dir_window_maps[] =
+    {
+        '_','_','w','i','n','e','_','w','i','n','d','o','w','_','m','a','p','p','i','n','g','s','\\',0
+    };
+    struct user_thread_info *thread_info = get_user_thread_info();
+    UINT handle = HandleToUlong( hwnd );
+    HANDLE root;
+    WCHAR buf[MAX_PATH];
+
+    if (LOWORD(handle) < FIRST_USER_HANDLE || LOWORD(handle) > LAST_USER_HANDLE) return NULL;
+
+    if (!thread_info->windows_shm)
+    {
+        get_desktop_mapping_path( dir_window_maps, buf, sizeof(buf) );
+
+        root = get_winstations_dir_handle();
+        thread_info->windows_shm = map_shared_memory_section( buf, WINDOW_SHM_ENTRIES * sizeof(window_shm_t), root );
+        NtClose( root );
+        if (!thread_info->windows_shm) return NULL;
+    }
+
+    return thread_info->windows_shm + WINDOW_SHM_INDEX( handle );
+}
+
 /***********************************************************************
  *           winstation_init
  *
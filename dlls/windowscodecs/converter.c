@@ -30,6 +30,10 @@
 
 #include "wine/debug.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 WINE_DEFAULT_DEBUG_CHANNEL(wincodecs);
 
 struct FormatConverter;
@@ -131,6 +135,155 @@ static void to_sRGB(BYTE *bgr)
 }
 #endif
 
+static void convert_row_24bppBGR_to_32bppBGRA(const BYTE *src, DWORD *dst, UINT width)
+{
+    UINT x = 0;
+
+    /* Four pixels are three source dwords. */
+    for (; x + 4 <= width; x += 4)
+    {
+        DWORD s[3];
+
+        memcpy(s, src, sizeof(s));
+        dst[0] = s[0] | 0xff000000;
+        dst[1] = (s[0] >> 24) | (s[1] << 8) | 0xff000000;
+        dst[2] = (s[1] >> 16) | (s[2] << 16) | 0xff000000;
+        dst[3] = (s[2] >> 8) | 0xff000000;
+        src += 12;
+        dst += 4;
+    }
+
+    for (; x < width; x++)
+    {
+        *dst++ = src[0] | src[1] << 8 | src[2] << 16 | 0xff000000;
+        src += 3;
+    }
+}
+
+static void convert_row_64bppRGBA_to_32bppBGRA(const WORD *src, DWORD *dst, UINT width)
+{
+    UINT x = 0;
+
+#if defined(__SSE2__)
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128i lo = _mm_loadu_si128((const __m128i *)src);
+        __m128i hi = _mm_loadu_si128((const __m128i *)(src + 8));
+
+        /* Keep the high byte of each channel and swap red and blue. */
+        lo = _mm_srli_epi16(lo, 8);
+        hi = _mm_srli_epi16(hi, 8);
+        lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+        hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+        _mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(lo, hi));
+        src += 16;
+        dst += 4;
+    }
+#endif
+
+    for (; x < width; x++)
+    {
+        *dst++ = (src[3] >> 8) << 24 | (src[0] >> 8) << 16 | (src[1] >> 8) << 8 | (src[2] >> 8);
+        src += 4;
+    }
+}
+
+static void set_alpha_32bpp(BYTE *bits, UINT width, UINT height, UINT stride)
+{
+    UINT x, y;
+
+    for (y = 0; y < height; y++)
+    {
+        DWORD *pixel = (DWORD *)(bits + stride * y);
+
+        for (x = 0; x < width; x++)
+            pixel[x] |= 0xff000000;
+    }
+}
+
+/* Computes (c * alpha + 127) / 255 for the colour channels. */
+static void premultiply_32bpp(BYTE *bits, UINT width, UINT height, UINT stride)
+{
+    UINT x, y;
+#if defined(__SSE2__)
+    const __m128i color_mask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alpha_one = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i bias = _mm_set1_epi16(127), one = _mm_set1_epi16(1);
+    const __m128i zero = _mm_setzero_si128();
+#endif
+
+    for (y = 0; y < height; y++)
+    {
+        BYTE *pixel = bits + stride * y;
+
+        x = 0;
+#if defined(__SSE2__)
+        for (; x + 4 <= width; x += 4)
+        {
+            __m128i src = _mm_loadu_si128((const __m128i *)pixel);
+            __m128i lo = _mm_unpacklo_epi8(src, zero), hi = _mm_unpackhi_epi8(src, zero);
+            __m128i alpha_lo, alpha_hi;
+
+            /* The alpha channel is multiplied by 255, which leaves it unchanged. */
+            alpha_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            alpha_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            alpha_lo = _mm_or_si128(_mm_and_si128(alpha_lo, color_mask), alpha_one);
+            alpha_hi = _mm_or_si128(_mm_and_si128(alpha_hi, color_mask), alpha_one);
+
+            /* n / 255 == (n + 1 + (n >> 8)) >> 8 for n < 65535. */
+            lo = _mm_add_epi16(_mm_mullo_epi16(lo, alpha_lo), bias);
+            hi = _mm_add_epi16(_mm_mullo_epi16(hi, alpha_hi), bias);
+            lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, one), _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, one), _mm_srli_epi16(hi, 8)), 8);
+            _mm_storeu_si128((__m128i *)pixel, _mm_packus_epi16(lo, hi));
+            pixel += 16;
+        }
+#endif
+
+        for (; x < width; x++)
+        {
+            BYTE alpha = pixel[3];
+            if (alpha != 255)
+            {
+                pixel[0] = (pixel[0] * alpha + 127) / 255;
+                pixel[1] = (pixel[1] * alpha + 127) / 255;
+                pixel[2] = (pixel[2] * alpha + 127) / 255;
+            }
+            pixel += 4;
+        }
+    }
+}
+
+/* Computes c * 255 / alpha for the colour channels. */
+static void unpremultiply_32bpp(BYTE *bits, UINT width, UINT height, UINT stride)
+{
+    UINT x, y, recip = 0;
+    BYTE last_alpha = 0;
+
+    for (y = 0; y < height; y++)
+    {
+        BYTE *pixel = bits + stride * y;
+
+        for (x = 0; x < width; x++, pixel += 4)
+        {
+            BYTE alpha = pixel[3];
+
+            if (alpha == 0 || alpha == 255) continue;
+
+            /* (c * ceil(255 * 65536 / alpha)) >> 16 is exact for 8-bit c,
+             * and a single division per alpha value is needed. */
+            if (alpha != last_alpha)
+            {
+                recip = (255 * 65536 + alpha - 1) / alpha;
+                last_alpha = alpha;
+            }
+            pixel[0] = (pixel[0] * recip) >> 16;
+            pixel[1] = (pixel[1] * recip) >> 16;
+            pixel[2] = (pixel[2] * recip) >> 16;
+        }
+    }
+}
+
 static inline FormatConverter *impl_from_IWICFormatConverter(IWICFormatConverter *iface)
 {
     return CONTAINING_RECORD(iface, FormatConverter, IWICFormatConverter_iface);
@@ -618,13 +771,11 @@ static HRESULT copypixels_to_32bppBGRA(struct FormatConverter *This, const WICRe
         if (prc)
         {
             HRESULT res;
-            INT x, y;
+            INT y;
             BYTE *srcdata;
             UINT srcstride, srcdatasize;
             const BYTE *srcrow;
-            const BYTE *srcpixel;
             BYTE *dstrow;
-            BYTE *dstpixel;
 
             srcstride = 3 * prc->Width;
             srcdatasize = srcstride * prc->Height;
@@ -639,14 +790,7 @@ static HRESULT copypixels_to_32bppBGRA(struct FormatConverter *This, const WICRe
                 srcrow = srcdata;
                 dstrow = pbBuffer;
                 for (y=0; y<prc->Height; y++) {
-                    srcpixel=srcrow;
-                    dstpixel=dstrow;
-                    for (x=0; x<prc->Width; x++) {
-                        *dstpixel++=*srcpixel++; /* blue */
-                        *dstpixel++=*srcpixel++; /* green */
-                        *dstpixel++=*srcpixel++; /* red */
-                        *dstpixel++=255; /* alpha */
-                    }
+                    convert_row_24bppBGR_to_32bppBGRA(srcrow, (DWORD *)dstrow, prc->Width);
                     srcrow += srcstride;
                     dstrow += cbStride;
                 }
@@ -709,15 +853,11 @@ static HRESULT copypixels_to_32bppBGRA(struct FormatConverter *This, const WICRe
         if (prc)
         {
             HRESULT res;
-            INT x, y;
 
             res = IWICBitmapSource_CopyPixels(This->source, prc, cbStride, cbBufferSize, pbBuffer);
             if (FAILED(res)) return res;
 
-            /* set all alpha values to 255 */
-            for (y=0; y<prc->Height; y++)
-                for (x=0; x<prc->Width; x++)
-                    pbBuffer[cbStride*y+4*x+3] = 0xff;
+            set_alpha_32bpp(pbBuffer, prc->Width, prc->Height, cbStride);
         }
         return S_OK;
     case format_32bppRGBA:
@@ -737,22 +877,11 @@ static HRESULT copypixels_to_32bppBGRA(struct FormatConverter *This, const WICRe
         if (prc)
         {
             HRESULT res;
-            INT x, y;
 
             res = IWICBitmapSource_CopyPixels(This->source, prc, cbStride, cbBufferSize, pbBuffer);
             if (FAILED(res)) return res;
 
-            for (y=0; y<prc->Height; y++)
-                for (x=0; x<prc->Width; x++)
-                {
-                    BYTE alpha = pbBuffer[cbStride*y+4*x+3];
-                    if (alpha != 0 && alpha != 255)
-                    {
-                        pbBuffer[cbStride*y+4*x] = pbBuffer[cbStride*y+4*x] * 255 / alpha;
-                        pbBuffer[cbStride*y+4*x+1] = pbBuffer[cbStride*y+4*x+1] * 255 / alpha;
-                        pbBuffer[cbStride*y+4*x+2] = pbBuffer[cbStride*y+4*x+2] * 255 / alpha;
-                    }
-                }
+            unpremultiply_32bpp(pbBuffer, prc->Width, prc->Height, cbStride);
         }
         return S_OK;
     case format_48bppRGB:
@@ -803,13 +932,11 @@ static HRESULT copypixels_to_32bppBGRA(struct FormatConverter *This, const WICRe
         if (prc)
         {
             HRESULT res;
-            INT x, y;
+            INT y;
             BYTE *srcdata;
             UINT srcstride, srcdatasize;
             const BYTE *srcrow;
-            const BYTE *srcpixel;
             BYTE *dstrow;
-            DWORD *dstpixel;
 
             srcstride = 8 * prc->Width;
             srcdatasize = srcstride * prc->Height;
@@ -824,16 +951,7 @@ static HRESULT copypixels_to_32bppBGRA(struct FormatConverter *This, const WICRe
                 srcrow = srcdata;
                 dstrow = pbBuffer;
                 for (y=0; y<prc->Height; y++) {
-                    srcpixel=srcrow;
-                    dstpixel=(DWORD*)dstrow;
-                    for (x=0; x<prc->Width; x++) {
-                        BYTE red, green, blue, alpha;
-                        srcpixel++; red = *srcpixel++;
-                        srcpixel++; green = *srcpixel++;
-                        srcpixel++; blue = *srcpixel++;
-                        srcpixel++; alpha = *srcpixel++;
-                        *dstpixel++=alpha<<24|red<<16|green<<8|blue;
-                    }
+                    convert_row_64bppRGBA_to_32bppBGRA((const WORD *)srcrow, (DWORD *)dstrow, prc->Width);
                     srcrow += srcstride;
                     dstrow += cbStride;
                 }
@@ -881,15 +999,10 @@ static HRESULT copypixels_to_32bppRGBA(struct FormatConverter *This, const WICRe
     case format_32bppRGB:
         if (prc)
         {
-            INT x, y;
-
             hr = IWICBitmapSource_CopyPixels(This->source, prc, cbStride, cbBufferSize, pbBuffer);
             if (FAILED(hr)) return hr;
 
-            /* set all alpha values to 255 */
-            for (y=0; y<prc->Height; y++)
-                for (x=0; x<prc->Width; x++)
-                    pbBuffer[cbStride*y+4*x+3] = 0xff;
+            set_alpha_32bpp(pbBuffer, prc->Width, prc->Height, cbStride);
         }
         return S_OK;
 
@@ -901,22 +1014,10 @@ static HRESULT copypixels_to_32bppRGBA(struct FormatConverter *This, const WICRe
     case format_32bppPRGBA:
         if (prc)
         {
-            INT x, y;
-
             hr = IWICBitmapSource_CopyPixels(This->source, prc, cbStride, cbBufferSize, pbBuffer);
             if (FAILED(hr)) return hr;
 
-            for (y=0; y<prc->Height; y++)
-                for (x=0; x<prc->Width; x++)
-                {
-                    BYTE alpha = pbBuffer[cbStride*y+4*x+3];
-                    if (alpha != 0 && alpha != 255)
-                    {
-                        pbBuffer[cbStride*y+4*x] = pbBuffer[cbStride*y+4*x] * 255 / alpha;
-                        pbBuffer[cbStride*y+4*x+1] = pbBuffer[cbStride*y+4*x+1] * 255 / alpha;
-                        pbBuffer[cbStride*y+4*x+2] = pbBuffer[cbStride*y+4*x+2] * 255 / alpha;
-                    }
-                }
+            unpremultiply_32bpp(pbBuffer, prc->Width, prc->Height, cbStride);
         }
         return S_OK;
 
@@ -974,21 +1075,7 @@ static HRESULT copypixels_to_32bppPBGRA(struct FormatConverter *This, const WICR
     default:
         hr = copypixels_to_32bppBGRA(This, prc, cbStride, cbBufferSize, pbBuffer, source_format);
         if (SUCCEEDED(hr) && prc)
-        {
-            INT x, y;
-
-            for (y=0; y<prc->Height; y++)
-                for (x=0; x<prc->Width; x++)
-                {
-                    BYTE alpha = pbBuffer[cbStride*y+4*x+3];
-                    if (alpha != 255)
-                    {
-                        pbBuffer[cbStride*y+4*x] = (pbBuffer[cbStride*y+4*x] * alpha + 127) / 255;
-                        pbBuffer[cbStride*y+4*x+1] = (pbBuffer[cbStride*y+4*x+1] * alpha + 127) / 255;
-                        pbBuffer[cbStride*y+4*x+2] = (pbBuffer[cbStride*y+4*x+2] * alpha + 127) / 255;
-                    }
-                }
-        }
+            premultiply_32bpp(pbBuffer, prc->Width, prc->Height, cbStride);
         return hr;
     }
 }
@@ -1007,21 +1094,7 @@ static HRESULT copypixels_to_32bppPRGBA(struct FormatConverter *This, const WICR
     default:
         hr = copypixels_to_32bppRGBA(This, prc, cbStride, cbBufferSize, pbBuffer, source_format);
         if (SUCCEEDED(hr) && prc)
-        {
-            INT x, y;
-
-            for (y=0; y<prc->Height; y++)
-                for (x=0; x<prc->Width; x++)
-                {
-                    BYTE alpha = pbBuffer[cbStride*y+4*x+3];
-                    if (alpha != 255)
-                    {
-                        pbBuffer[cbStride*y+4*x] = (pbBuffer[cbStride*y+4*x] * alpha + 127) / 255;
-                        pbBuffer[cbStride*y+4*x+1] = (pbBuffer[cbStride*y+4*x+1] * alpha + 127) / 255;
-                        pbBuffer[cbStride*y+4*x+2] = (pbBuffer[cbStride*y+4*x+2] * alpha + 127) / 255;
-                    }
-                }
-        }
+            premultiply_32bpp(pbBuffer, prc->Width, prc->Height, cbStride);
         return hr;
     }
 }
@@ -1384,16 +1457,27 @@ static HRESULT copypixels_to_8bppGray(struct FormatConverter *This, const WICRec
         INT x, y;
         BYTE *src = srcdata, *dst = pbBuffer;
 
+        DWORD last_bgr = ~0u;
+        BYTE last_gray = 0;
+
         for (y = 0; y < prc->Height; y++)
         {
             BYTE *bgr = src;
 
             for (x = 0; x < prc->Width; x++)
             {
-                float gray = (bgr[2] * 0.2126f + bgr[1] * 0.7152f + bgr[0] * 0.0722f) / 255.0f;
+                DWORD color = bgr[0] | bgr[1] << 8 | bgr[2] << 16;
 
-                gray = to_sRGB_component(gray) * 255.0f;
-                dst[x] = (BYTE)floorf(gray + 0.51f);
+                /* Runs of identical pixels are common, and powf() dominates the cost. */
+                if (color != last_bgr)
+                {
+                    float gray = (bgr[2] * 0.2126f + bgr[1] * 0.7152f + bgr[0] * 0.0722f) / 255.0f;
+
+                    gray = to_sRGB_component(gray) * 255.0f;
+                    last_gray = (BYTE)floorf(gray + 0.51f);
+                    last_bgr = color;
+                }
+                dst[x] = last_gray;
                 bgr += 3;
             }
             src += srcstride;
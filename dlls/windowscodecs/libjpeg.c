@@ -78,8 +78,11 @@ struct jpeg_decoder {
     struct jpeg_error_mgr jerr;
     struct jpeg_source_mgr source_mgr;
     BYTE source_buffer[1024];
+    ULONGLONG stream_pos;
     UINT stride;
     BYTE *image_data;
+    UINT image_lines; /* number of lines image_data can hold */
+    BOOL decode_failed;
 };
 
 static inline struct jpeg_decoder *impl_from_decoder(struct decoder* iface)
@@ -145,12 +148,84 @@ static void source_mgr_term_source(j_decompress_ptr cinfo)
 {
 }
 
+static HRESULT jpeg_decoder_read_lines(struct jpeg_decoder *This, UINT lines)
+{
+    UINT first_line = This->cinfo.output_scanline, i;
+    jmp_buf jmpbuf;
+
+    if (This->decode_failed)
+        return E_FAIL;
+
+    if (lines <= first_line)
+        return S_OK;
+
+    if (lines > This->image_lines)
+    {
+        UINT new_lines = max(lines, min(This->image_lines * 2, This->frame.height));
+        BYTE *new_data;
+
+        if (!(new_data = realloc(This->image_data, This->stride * new_lines)))
+            return E_OUTOFMEMORY;
+        This->image_data = new_data;
+        This->image_lines = new_lines;
+    }
+
+    This->cinfo.client_data = jmpbuf;
+
+    if (setjmp(jmpbuf))
+    {
+        This->decode_failed = TRUE;
+        return E_FAIL;
+    }
+
+    stream_seek(This->stream, This->stream_pos, STREAM_SEEK_SET, NULL);
+
+    while (This->cinfo.output_scanline < lines)
+    {
+        UINT first_scanline = This->cinfo.output_scanline;
+        UINT max_rows;
+        JSAMPROW out_rows[4];
+        JDIMENSION ret;
+
+        max_rows = min(lines-first_scanline, 4);
+        for (i=0; i<max_rows; i++)
+            out_rows[i] = This->image_data + This->stride * (first_scanline+i);
+
+        ret = jpeg_read_scanlines(&This->cinfo, out_rows, max_rows);
+        if (ret == 0)
+        {
+            ERR("read_scanlines failed\n");
+            This->decode_failed = TRUE;
+            return E_FAIL;
+        }
+    }
+
+    stream_seek(This->stream, 0, STREAM_SEEK_CUR, &This->stream_pos);
+
+    if (This->frame.bpp == 24)
+    {
+        /* libjpeg gives us RGB data and we want BGR, so byteswap the data */
+        reverse_bgr8(3, This->image_data + This->stride * first_line,
+            This->cinfo.output_width, lines - first_line,
+            This->stride);
+    }
+
+    if (This->cinfo.out_color_space == JCS_CMYK && This->cinfo.saw_Adobe_marker)
+    {
+        /* Adobe JPEG's have inverted CMYK data. */
+        for (i=This->stride * first_line; i<This->stride * lines; i++)
+            This->image_data[i] ^= 0xff;
+    }
+
+    return S_OK;
+}
+
 static HRESULT CDECL jpeg_decoder_initialize(struct decoder* iface, IStream *stream, struct decoder_stat *st)
 {
     struct jpeg_decoder *This = impl_from_decoder(iface);
     int ret;
     jmp_buf jmpbuf;
-    UINT data_size, i;
+    HRESULT hr;
 
     if (This->cinfo_initialized)
         return WINCODEC_ERR_WRONGSTATE;
@@ -246,45 +321,13 @@ static HRESULT CDECL jpeg_decoder_initialize(struct decoder* iface, IStream *str
     This->frame.num_colors = 0;
 
     This->stride = (This->frame.bpp * This->cinfo.output_width + 7) / 8;
-    data_size = This->stride * This->cinfo.output_height;
-
-    This->image_data = malloc(data_size);
-    if (!This->image_data)
-        return E_OUTOFMEMORY;
-
-    while (This->cinfo.output_scanline < This->cinfo.output_height)
-    {
-        UINT first_scanline = This->cinfo.output_scanline;
-        UINT max_rows;
-        JSAMPROW out_rows[4];
-        JDIMENSION ret;
-
-        max_rows = min(This->cinfo.output_height-first_scanline, 4);
-        for (i=0; i<max_rows; i++)
-            out_rows[i] = This->image_data + This->stride * (first_scanline+i);
-
-        ret = jpeg_read_scanlines(&This->cinfo, out_rows, max_rows);
-        if (ret == 0)
-        {
-            ERR("read_scanlines failed\n");
-            return E_FAIL;
-        }
-    }
 
-    if (This->frame.bpp == 24)
-    {
-        /* libjpeg gives us RGB data and we want BGR, so byteswap the data */
-        reverse_bgr8(3, This->image_data,
-            This->cinfo.output_width, This->cinfo.output_height,
-            This->stride);
-    }
+    /* Scanlines are decoded on demand, remember where libjpeg stopped reading. */
+    stream_seek(This->stream, 0, STREAM_SEEK_CUR, &This->stream_pos);
 
-    if (This->cinfo.out_color_space == JCS_CMYK && This->cinfo.saw_Adobe_marker)
-    {
-        /* Adobe JPEG's have inverted CMYK data. */
-        for (i=0; i<data_size; i++)
-            This->image_data[i] ^= 0xff;
-    }
+    /* Decode the first scanline to catch broken image data early. */
+    if (FAILED(hr = jpeg_decoder_read_lines(This, 1)))
+        return hr;
 
     st->frame_count = 1;
     st->flags = WICBitmapDecoderCapabilityCanDecodeAllImages |
@@ -305,6 +348,16 @@ static HRESULT CDECL jpeg_decoder_copy_pixels(struct decoder* iface, UINT frame,
     const WICRect *prc, UINT stride, UINT buffersize, BYTE *buffer)
 {
     struct jpeg_decoder *This = impl_from_decoder(iface);
+    UINT lines = This->frame.height;
+    HRESULT hr;
+
+    /* Only decode up to the last requested line, copy_pixels() validates the rectangle. */
+    if (prc && prc->Y >= 0 && prc->Height >= 0)
+        lines = min(lines, prc->Y + prc->Height);
+
+    if (FAILED(hr = jpeg_decoder_read_lines(This, lines)))
+        return hr;
+
     return copy_pixels(This->frame.bpp, This->image_data,
         This->frame.width, This->frame.height, This->stride,
         prc, stride, buffersize, buffer);
@@ -347,6 +400,8 @@ HRESULT CDECL jpeg_decoder_create(struct decoder_info *info, struct decoder **re
     This->cinfo_initialized = FALSE;
     This->stream = NULL;
     This->image_data = NULL;
+    This->image_lines = 0;
+    This->decode_failed = FALSE;
     *result = &This->decoder;
 
     info->container_format = GUID_ContainerFormatJpeg;
@@ -38,8 +38,15 @@ struct png_decoder
     struct decoder decoder;
     IStream *stream;
     struct decoder_frame decoder_frame;
+    png_structp png_ptr;
+    png_infop info_ptr;
+    int interlace_passes;
+    ULONGLONG stream_pos;
     UINT stride;
     BYTE *image_bits;
+    UINT image_lines; /* number of lines image_bits can hold */
+    UINT decoded_lines;
+    BOOL decode_failed;
     BYTE *color_profile;
     DWORD color_profile_len;
 };
@@ -62,6 +69,53 @@ static void user_read_data(png_structp png_ptr, png_bytep data, png_size_t lengt
     }
 }
 
+static HRESULT png_decoder_read_lines(struct png_decoder *This, UINT lines)
+{
+    UINT first_line = This->decoded_lines, i;
+    int pass;
+
+    if (This->decode_failed)
+        return E_FAIL;
+
+    if (This->interlace_passes > 1)
+        lines = This->decoder_frame.height;
+
+    if (lines <= first_line)
+        return S_OK;
+
+    if (lines > This->image_lines)
+    {
+        UINT new_lines = max(lines, min(This->image_lines * 2, This->decoder_frame.height));
+        BYTE *new_bits;
+
+        if (!(new_bits = realloc(This->image_bits, This->stride * new_lines)))
+            return E_OUTOFMEMORY;
+        This->image_bits = new_bits;
+        This->image_lines = new_lines;
+    }
+
+    if (setjmp(png_jmpbuf(This->png_ptr)))
+    {
+        This->decode_failed = TRUE;
+        return E_FAIL;
+    }
+
+    stream_seek(This->stream, This->stream_pos, STREAM_SEEK_SET, NULL);
+
+    for (pass = 0; pass < This->interlace_passes; pass++)
+    {
+        for (i = first_line; i < lines; i++)
+            png_read_row(This->png_ptr, This->image_bits + i * This->stride, NULL);
+    }
+
+    /* png_read_end intentionally not called to not seek to the end of the file */
+
+    stream_seek(This->stream, 0, STREAM_SEEK_CUR, &This->stream_pos);
+    This->decoded_lines = lines;
+
+    return S_OK;
+}
+
 static HRESULT CDECL png_decoder_initialize(struct decoder *iface, IStream *stream, struct decoder_stat *st)
 {
     struct png_decoder *This = impl_from_decoder(iface);
@@ -78,8 +132,6 @@ static HRESULT CDECL png_decoder_initialize(struct decoder *iface, IStream *stre
     png_colorp png_palette;
     int num_palette;
     int i;
-    UINT image_size;
-    png_bytep *row_pointers=NULL;
     png_charp cp_name;
     png_bytep cp_profile;
     png_uint_32 cp_len;
@@ -294,48 +346,45 @@ static HRESULT CDECL png_decoder_initialize(struct decoder *iface, IStream *stre
     }
 
     This->stride = (This->decoder_frame.width * This->decoder_frame.bpp + 7) / 8;
-    image_size = This->stride * This->decoder_frame.height;
 
-    This->image_bits = malloc(image_size);
-    if (!This->image_bits)
+    /* Rows are decoded on demand, interlaced images have to be decoded at once. */
+    This->interlace_passes = png_set_interlace_handling(png_ptr);
+    png_read_update_info(png_ptr, info_ptr);
+
+    hr = stream_seek(stream, 0, STREAM_SEEK_CUR, &This->stream_pos);
+    if (FAILED(hr))
     {
-        hr = E_OUTOFMEMORY;
         goto end;
     }
 
-    row_pointers = malloc(sizeof(png_bytep)*This->decoder_frame.height);
-    if (!row_pointers)
+    This->png_ptr = png_ptr;
+    This->info_ptr = info_ptr;
+    This->stream = stream;
+
+    /* Decode the first row to catch broken image data early. */
+    hr = png_decoder_read_lines(This, 1);
+    if (FAILED(hr))
     {
-        hr = E_OUTOFMEMORY;
         goto end;
     }
 
-    for (i=0; i<This->decoder_frame.height; i++)
-        row_pointers[i] = This->image_bits + i * This->stride;
-
-    png_read_image(png_ptr, row_pointers);
-
-    free(row_pointers);
-    row_pointers = NULL;
-
-    /* png_read_end intentionally not called to not seek to the end of the file */
-
     st->flags = WICBitmapDecoderCapabilityCanDecodeAllImages |
                 WICBitmapDecoderCapabilityCanDecodeSomeImages |
                 WICBitmapDecoderCapabilityCanEnumerateMetadata;
     st->frame_count = 1;
 
-    This->stream = stream;
-
     hr = S_OK;
 
 end:
-    png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
-    free(row_pointers);
     if (FAILED(hr))
     {
+        png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
+        This->png_ptr = NULL;
+        This->info_ptr = NULL;
         free(This->image_bits);
         This->image_bits = NULL;
+        This->image_lines = This->decoded_lines = 0;
+        This->decode_failed = FALSE;
         free(This->color_profile);
         This->color_profile = NULL;
     }
@@ -353,6 +402,15 @@ static HRESULT CDECL png_decoder_copy_pixels(struct decoder *iface, UINT frame,
     const WICRect *prc, UINT stride, UINT buffersize, BYTE *buffer)
 {
     struct png_decoder *This = impl_from_decoder(iface);
+    UINT lines = This->decoder_frame.height;
+    HRESULT hr;
+
+    /* Only decode up to the last requested line, copy_pixels() validates the rectangle. */
+    if (prc && prc->Y >= 0 && prc->Height >= 0)
+        lines = min(lines, prc->Y + prc->Height);
+
+    if (FAILED(hr = png_decoder_read_lines(This, lines)))
+        return hr;
 
     return copy_pixels(This->decoder_frame.bpp, This->image_bits,
         This->decoder_frame.width, This->decoder_frame.height, This->stride,
@@ -451,6 +509,8 @@ static void CDECL png_decoder_destroy(struct decoder* iface)
 {
     struct png_decoder *This = impl_from_decoder(iface);
 
+    if (This->png_ptr)
+        png_destroy_read_struct(&This->png_ptr, &This->info_ptr, NULL);
     free(This->image_bits);
     free(This->color_profile);
     free(This);
@@ -477,7 +537,12 @@ HRESULT CDECL png_decoder_create(struct decoder_info *info, struct decoder **res
     }
 
     This->decoder.vtable = &png_decoder_vtable;
+    This->png_ptr = NULL;
+    This->info_ptr = NULL;
     This->image_bits = NULL;
+    This->image_lines = 0;
+    This->decoded_lines = 0;
+    This->decode_failed = FALSE;
     This->color_profile = NULL;
     *result = &This->decoder;
 
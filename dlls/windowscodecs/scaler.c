@@ -18,6 +18,7 @@
  */
 
 #include <stdarg.h>
+#include <math.h>
 
 #define COBJMACROS
 
@@ -29,8 +30,33 @@
 
 #include "wine/debug.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 WINE_DEFAULT_DEBUG_CHANNEL(wincodecs);
 
+#define FILTER_BITS 12
+
+/* Fixed point filter taps for one axis. Destination pixel i is computed from
+ * source pixels start[i] .. start[i] + count[i] - 1, with the weights at
+ * weights[i * max_taps]. Both start[i] and start[i] + count[i] are
+ * non-decreasing in i. */
+struct scaler_filter
+{
+    UINT *start;
+    UINT *count;
+    short *weights;
+    UINT max_taps;
+};
+
+static void free_scaler_filter(struct scaler_filter *filter)
+{
+    free(filter->start);
+    free(filter->count);
+    free(filter->weights);
+}
+
 typedef struct BitmapScaler {
     IWICBitmapScaler IWICBitmapScaler_iface;
     LONG ref;
@@ -42,6 +68,9 @@ typedef struct BitmapScaler {
     UINT bpp;
     void (*fn_get_required_source_rect)(struct BitmapScaler*,UINT,UINT,WICRect*);
     void (*fn_copy_scanline)(struct BitmapScaler*,UINT,UINT,UINT,BYTE**,UINT,UINT,BYTE*);
+    UINT channels;
+    struct scaler_filter filter_x, filter_y;
+    INT *filter_row;
     CRITICAL_SECTION lock; /* must be held when initialized */
 } BitmapScaler;
 
@@ -106,6 +135,9 @@ static ULONG WINAPI BitmapScaler_Release(IWICBitmapScaler *iface)
         This->lock.DebugInfo->Spare[0] = 0;
         DeleteCriticalSection(&This->lock);
         if (This->source) IWICBitmapSource_Release(This->source);
+        free_scaler_filter(&This->filter_x);
+        free_scaler_filter(&This->filter_y);
+        free(This->filter_row);
         free(This);
     }
 
@@ -203,6 +235,228 @@ static void NearestNeighbor_CopyScanline(BitmapScaler *This,
     }
 }
 
+static double linear_kernel(double x)
+{
+    x = fabs(x);
+    return x < 1.0 ? 1.0 - x : 0.0;
+}
+
+/* Catmull-Rom spline, a = -0.5. */
+static double cubic_kernel(double x)
+{
+    x = fabs(x);
+    if (x < 1.0) return (1.5 * x - 2.5) * x * x + 1.0;
+    if (x < 2.0) return ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0;
+    return 0.0;
+}
+
+static HRESULT init_scaler_filter(struct scaler_filter *filter, WICBitmapInterpolationMode mode,
+    UINT src_size, UINT dst_size)
+{
+    double scale = (double)src_size / dst_size, filter_scale = max(scale, 1.0);
+    double (*kernel)(double) = linear_kernel;
+    double radius = 1.0, support, *taps;
+    BOOL box = FALSE;
+    UINT i, j;
+
+    switch (mode)
+    {
+    case WICBitmapInterpolationModeCubic:
+        kernel = cubic_kernel;
+        radius = 2.0;
+        break;
+    case WICBitmapInterpolationModeFant:
+        /* Fant averages the covered source area when shrinking, and
+         * interpolates linearly when enlarging. */
+        if (scale > 1.0)
+        {
+            box = TRUE;
+            radius = 0.5;
+        }
+        break;
+    default:
+        break;
+    }
+
+    support = radius * filter_scale;
+    filter->max_taps = min((UINT)ceil(2.0 * support) + 3, src_size);
+
+    filter->start = malloc(dst_size * sizeof(*filter->start));
+    filter->count = malloc(dst_size * sizeof(*filter->count));
+    filter->weights = malloc(dst_size * filter->max_taps * sizeof(*filter->weights));
+    taps = malloc(filter->max_taps * sizeof(*taps));
+    if (!filter->start || !filter->count || !filter->weights || !taps)
+    {
+        free(taps);
+        return E_OUTOFMEMORY;
+    }
+
+    for (i = 0; i < dst_size; i++)
+    {
+        double center = (i + 0.5) * scale, total = 0.0;
+        INT first = floor(center - support - 0.5), last = ceil(center + support + 0.5);
+        short *weights = filter->weights + i * filter->max_taps;
+        UINT count, largest = 0;
+        INT sum = 0;
+
+        first = max(first, 0);
+        last = min(last, (INT)src_size);
+        count = last - first;
+
+        for (j = 0; j < count; j++)
+        {
+            double pos = first + j;
+
+            if (box)
+                taps[j] = max(0.0, min(pos + 1.0, center + support) - max(pos, center - support));
+            else
+                taps[j] = kernel((pos + 0.5 - center) / filter_scale);
+            total += taps[j];
+        }
+
+        for (j = 0; j < count; j++)
+        {
+            weights[j] = floor(taps[j] / total * (1 << FILTER_BITS) + 0.5);
+            sum += weights[j];
+            if (taps[j] > taps[largest]) largest = j;
+        }
+        /* Make the taps sum to exactly one, so that flat areas stay flat. */
+        weights[largest] += (1 << FILTER_BITS) - sum;
+
+        filter->start[i] = first;
+        filter->count[i] = count;
+    }
+
+    free(taps);
+    return S_OK;
+}
+
+/* Returns the number of 8-bit channels of a format that can be filtered
+ * channel by channel, or 0. */
+static UINT get_filter_channels(const WICPixelFormatGUID *format)
+{
+    if (IsEqualGUID(format, &GUID_WICPixelFormat8bppGray))
+        return 1;
+    if (IsEqualGUID(format, &GUID_WICPixelFormat24bppBGR) ||
+        IsEqualGUID(format, &GUID_WICPixelFormat24bppRGB))
+        return 3;
+    if (IsEqualGUID(format, &GUID_WICPixelFormat32bppBGR) ||
+        IsEqualGUID(format, &GUID_WICPixelFormat32bppBGRA) ||
+        IsEqualGUID(format, &GUID_WICPixelFormat32bppPBGRA) ||
+        IsEqualGUID(format, &GUID_WICPixelFormat32bppRGB) ||
+        IsEqualGUID(format, &GUID_WICPixelFormat32bppRGBA) ||
+        IsEqualGUID(format, &GUID_WICPixelFormat32bppPRGBA))
+        return 4;
+    return 0;
+}
+
+static void Filter_GetRequiredSourceRect(BitmapScaler *This,
+    UINT x, UINT y, WICRect *src_rect)
+{
+    src_rect->X = This->filter_x.start[x];
+    src_rect->Y = This->filter_y.start[y];
+    src_rect->Width = This->filter_x.count[x];
+    src_rect->Height = This->filter_y.count[y];
+}
+
+/* Vertical pass, keeping 4 fractional bits of the result. */
+static void filter_columns(INT *dst, BYTE **rows, const short *weights, UINT count, UINT offset, UINT size)
+{
+    UINT i = 0, k;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128(), round = _mm_set1_epi32(1 << 3);
+
+    for (; i + 8 <= size; i += 8)
+    {
+        __m128i sum_lo = round, sum_hi = round;
+
+        for (k = 0; k < count; k += 2)
+        {
+            const BYTE *row1 = rows[k] + offset + i, *row2 = rows[k + 1 < count ? k + 1 : k] + offset + i;
+            __m128i w = _mm_set1_epi32((k + 1 < count ? (UINT)(USHORT)weights[k + 1] << 16 : 0) | (USHORT)weights[k]);
+            __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)row1), zero);
+            __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)row2), zero);
+
+            sum_lo = _mm_add_epi32(sum_lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), w));
+            sum_hi = _mm_add_epi32(sum_hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), w));
+        }
+        _mm_storeu_si128((__m128i *)&dst[i], _mm_srai_epi32(sum_lo, 4));
+        _mm_storeu_si128((__m128i *)&dst[i + 4], _mm_srai_epi32(sum_hi, 4));
+    }
+#endif
+
+    for (; i < size; i++)
+    {
+        INT sum = 1 << 3;
+
+        for (k = 0; k < count; k++)
+            sum += weights[k] * rows[k][offset + i];
+        dst[i] = sum >> 4;
+    }
+}
+
+static void Filter_CopyScanline(BitmapScaler *This,
+    UINT dst_x, UINT dst_y, UINT dst_width,
+    BYTE **src_data, UINT src_data_x, UINT src_data_y, BYTE *pbBuffer)
+{
+    const struct scaler_filter *fx = &This->filter_x, *fy = &This->filter_y;
+    UINT channels = This->channels, first_x = fx->start[dst_x];
+    UINT last_x = fx->start[dst_x + dst_width - 1] + fx->count[dst_x + dst_width - 1];
+    INT *row = This->filter_row;
+    UINT i, k, c;
+
+    filter_columns(row, src_data + fy->start[dst_y] - src_data_y, fy->weights + dst_y * fy->max_taps,
+            fy->count[dst_y], (first_x - src_data_x) * channels, (last_x - first_x) * channels);
+
+    for (i = 0; i < dst_width; i++)
+    {
+        const short *weights = fx->weights + (dst_x + i) * fx->max_taps;
+        const INT *src = row + (fx->start[dst_x + i] - first_x) * channels;
+        UINT count = fx->count[dst_x + i];
+
+        for (c = 0; c < channels; c++)
+        {
+            INT sum = 1 << (2 * FILTER_BITS - 4 - 1);
+
+            for (k = 0; k < count; k++)
+                sum += weights[k] * src[k * channels + c];
+            sum >>= 2 * FILTER_BITS - 4;
+            *pbBuffer++ = sum < 0 ? 0 : sum > 255 ? 255 : sum;
+        }
+    }
+}
+
+static HRESULT init_filter_scaler(BitmapScaler *This, IWICBitmapSource *source,
+    WICBitmapInterpolationMode mode)
+{
+    HRESULT hr = S_OK;
+
+    if (!(This->filter_row = malloc(This->src_width * This->channels * sizeof(*This->filter_row))))
+        hr = E_OUTOFMEMORY;
+    if (SUCCEEDED(hr))
+        hr = init_scaler_filter(&This->filter_x, mode, This->src_width, This->width);
+    if (SUCCEEDED(hr))
+        hr = init_scaler_filter(&This->filter_y, mode, This->src_height, This->height);
+
+    if (FAILED(hr))
+    {
+        free_scaler_filter(&This->filter_x);
+        free_scaler_filter(&This->filter_y);
+        free(This->filter_row);
+        memset(&This->filter_x, 0, sizeof(This->filter_x));
+        memset(&This->filter_y, 0, sizeof(This->filter_y));
+        This->filter_row = NULL;
+        return hr;
+    }
+
+    IWICBitmapSource_AddRef(source);
+    This->source = source;
+    This->fn_get_required_source_rect = Filter_GetRequiredSourceRect;
+    This->fn_copy_scanline = Filter_CopyScanline;
+    return S_OK;
+}
+
 static HRESULT WINAPI BitmapScaler_CopyPixels(IWICBitmapScaler *iface,
     const WICRect *prc, UINT cbStride, UINT cbBufferSize, BYTE *pbBuffer)
 {
@@ -351,8 +605,17 @@ static HRESULT WINAPI BitmapScaler_Initialize(IWICBitmapScaler *iface,
     {
         switch (mode)
         {
+        case WICBitmapInterpolationModeLinear:
+        case WICBitmapInterpolationModeCubic:
+        case WICBitmapInterpolationModeFant:
+            if ((This->channels = get_filter_channels(&src_pixelformat)))
+            {
+                hr = init_filter_scaler(This, pISource, mode);
+                break;
+            }
+            /* fall-through */
         default:
-            FIXME("unsupported mode %i\n", mode);
+            FIXME("unsupported mode %i for format %s\n", mode, debugstr_guid(&src_pixelformat));
             /* fall-through */
         case WICBitmapInterpolationModeNearestNeighbor:
             if ((This->bpp % 8) == 0)
@@ -527,6 +790,10 @@ HRESULT BitmapScaler_Create(IWICBitmapScaler **scaler)
     This->src_height = 0;
     This->mode = 0;
     This->bpp = 0;
+    This->channels = 0;
+    memset(&This->filter_x, 0, sizeof(This->filter_x));
+    memset(&This->filter_y, 0, sizeof(This->filter_y));
+    This->filter_row = NULL;
     InitializeCriticalSection(&This->lock);
     This->lock.DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": BitmapScaler.lock");
 
@@ -1315,6 +1315,175 @@ static void test_bitmap_scaler(void)
     IWICBitmap_Release(bitmap);
 }
 
+/* Value of the source ramp at the centre of destination pixel x. */
+static int ramp_value(UINT x, UINT width)
+{
+    return floor(12.0 * ((x + 0.5) * 20.0 / width - 0.5) + 6.0 + 0.5);
+}
+
+static void test_bitmap_scaler_interpolation(void)
+{
+    static const WICBitmapInterpolationMode modes[] =
+    {
+        WICBitmapInterpolationModeNearestNeighbor,
+        WICBitmapInterpolationModeLinear,
+        WICBitmapInterpolationModeCubic,
+        WICBitmapInterpolationModeFant,
+    };
+    static const struct
+    {
+        UINT width, height;
+    }
+    sizes[] =
+    {
+        {5, 3}, {17, 11}, {40, 40},
+    };
+    IWICBitmapScaler *scaler;
+    IWICBitmap *bitmap;
+    BYTE src[20 * 20 * 4], buf[40 * 40 * 4];
+    unsigned int i, j, k;
+    HRESULT hr;
+
+    for (i = 0; i < sizeof(src) / 4; i++)
+    {
+        src[i * 4] = 0x10;
+        src[i * 4 + 1] = 0x80;
+        src[i * 4 + 2] = 0xf0;
+        src[i * 4 + 3] = 0xff;
+    }
+
+    hr = IWICImagingFactory_CreateBitmapFromMemory(factory, 20, 20, &GUID_WICPixelFormat32bppBGRA,
+        20 * 4, sizeof(src), src, &bitmap);
+    ok(hr == S_OK, "Failed to create a bitmap, hr %#lx.\n", hr);
+
+    for (i = 0; i < ARRAY_SIZE(modes); i++)
+    {
+        for (j = 0; j < ARRAY_SIZE(sizes); j++)
+        {
+            winetest_push_context("mode %u, %ux%u", modes[i], sizes[j].width, sizes[j].height);
+
+            hr = IWICImagingFactory_CreateBitmapScaler(factory, &scaler);
+            ok(hr == S_OK, "Failed to create bitmap scaler, hr %#lx.\n", hr);
+
+            hr = IWICBitmapScaler_Initialize(scaler, (IWICBitmapSource *)bitmap,
+                sizes[j].width, sizes[j].height, modes[i]);
+            ok(hr == S_OK, "Failed to initialize bitmap scaler, hr %#lx.\n", hr);
+
+            memset(buf, 0, sizeof(buf));
+            hr = IWICBitmapScaler_CopyPixels(scaler, NULL, sizes[j].width * 4, sizeof(buf), buf);
+            ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+
+            /* A solid colour stays solid whatever the filter. */
+            for (k = 0; k < sizes[j].width * sizes[j].height; k++)
+            {
+                if (*(DWORD *)&buf[k * 4] != 0xfff08010) break;
+            }
+            ok(k == sizes[j].width * sizes[j].height, "Got unexpected pixel at %u.\n", k);
+
+            IWICBitmapScaler_Release(scaler);
+
+            winetest_pop_context();
+        }
+    }
+
+    IWICBitmap_Release(bitmap);
+
+    /* A left to right ramp, and a vertical edge in the middle of the image. */
+    for (i = 0; i < 2; i++)
+    {
+        for (j = 0; j < 20 * 20; j++)
+        {
+            BYTE value = i ? (j % 20 < 10 ? 0x00 : 0xff) : (j % 20) * 12 + 6;
+
+            src[j * 4] = src[j * 4 + 1] = src[j * 4 + 2] = value;
+            src[j * 4 + 3] = 0xff;
+        }
+
+        hr = IWICImagingFactory_CreateBitmapFromMemory(factory, 20, 20, &GUID_WICPixelFormat32bppBGRA,
+            20 * 4, sizeof(src), src, &bitmap);
+        ok(hr == S_OK, "Failed to create a bitmap, hr %#lx.\n", hr);
+
+        for (j = 0; j < ARRAY_SIZE(modes); j++)
+        {
+            for (k = 0; k < ARRAY_SIZE(sizes); k++)
+            {
+                UINT width = sizes[k].width, height = sizes[k].height, x, y, mid = 0;
+                BOOL monotonic = TRUE, symmetric = TRUE, uniform = TRUE, exact = TRUE;
+
+                winetest_push_context("%s, mode %u, %ux%u", i ? "edge" : "ramp", modes[j], width, height);
+
+                hr = IWICImagingFactory_CreateBitmapScaler(factory, &scaler);
+                ok(hr == S_OK, "Failed to create bitmap scaler, hr %#lx.\n", hr);
+
+                hr = IWICBitmapScaler_Initialize(scaler, (IWICBitmapSource *)bitmap, width, height, modes[j]);
+                ok(hr == S_OK, "Failed to initialize bitmap scaler, hr %#lx.\n", hr);
+
+                memset(buf, 0, sizeof(buf));
+                hr = IWICBitmapScaler_CopyPixels(scaler, NULL, width * 4, sizeof(buf), buf);
+                ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+
+                for (y = 0; y < height; y++)
+                {
+                    const BYTE *row = buf + y * width * 4;
+
+                    for (x = 0; x < width; x++)
+                    {
+                        if (row[x * 4] != row[x * 4 + 1] || row[x * 4] != row[x * 4 + 2]
+                                || row[x * 4 + 3] != 0xff || row[x * 4] != buf[x * 4])
+                            uniform = FALSE;
+                        if (x && row[x * 4] + 1 < row[(x - 1) * 4])
+                            monotonic = FALSE;
+                        /* Filters differ in rounding and kernel shape, so only
+                         * allow deviations smaller than one source step. */
+                        if (i && abs(row[x * 4] + row[(width - 1 - x) * 4] - 0xff) > 12)
+                            symmetric = FALSE;
+                        /* Away from the borders, interpolating filters reproduce a
+                         * linear ramp at the centre of each destination pixel. */
+                        if (!i && modes[j] != WICBitmapInterpolationModeNearestNeighbor
+                                && x && x < width - 1 && abs(row[x * 4] - ramp_value(x, width)) > 12)
+                            exact = FALSE;
+                        if (row[x * 4] > 0x01 && row[x * 4] < 0xfe)
+                            ++mid;
+                    }
+                }
+
+                /* Every channel and every row is filtered the same way. */
+                ok(uniform, "Got non-uniform pixels.\n");
+                if (i)
+                {
+                    /* Away from the edge, the interpolated image keeps the
+                     * source colours; the filter must not shift the edge. */
+                    ok(buf[0] < 0x08, "Got left pixel %#x.\n", buf[0]);
+                    ok(buf[(width - 1) * 4] > 0xf7, "Got right pixel %#x.\n", buf[(width - 1) * 4]);
+                    if (modes[j] != WICBitmapInterpolationModeNearestNeighbor)
+                        ok(symmetric, "Got asymmetric edge.\n");
+                    /* Cubic filters may ring around the edge. */
+                    if (modes[j] != WICBitmapInterpolationModeCubic)
+                        ok(monotonic, "Got non-monotonic edge.\n");
+                    /* Only nearest neighbour keeps the edge sharp when enlarging. */
+                    if (modes[j] == WICBitmapInterpolationModeNearestNeighbor)
+                        ok(!mid, "Got %u interpolated pixels.\n", mid);
+                    else if (width > 20)
+                        ok(mid, "Got no interpolated pixels.\n");
+                }
+                else
+                {
+                    ok(monotonic, "Got non-monotonic ramp.\n");
+                    ok(exact, "Got unexpected ramp values.\n");
+                    ok(buf[0] < 0x40, "Got left pixel %#x.\n", buf[0]);
+                    ok(buf[(width - 1) * 4] > 0xc0, "Got right pixel %#x.\n", buf[(width - 1) * 4]);
+                }
+
+                IWICBitmapScaler_Release(scaler);
+
+                winetest_pop_context();
+            }
+        }
+
+        IWICBitmap_Release(bitmap);
+    }
+}
+
 static LONG obj_refcount(void *obj)
 {
     IUnknown_AddRef((IUnknown *)obj);
@@ -1485,6 +1654,7 @@ START_TEST(bitmap)
     test_CreateBitmapFromHBITMAP();
     test_clipper();
     test_bitmap_scaler();
+    test_bitmap_scaler_interpolation();
 
     IWICImagingFactory_Release(factory);
 
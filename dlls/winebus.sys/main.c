@@ -414,33 +414,38 @@ static DWORD check_bus_option(const WCHAR *option, DWORD default_value)
     return default_value;
 }
 
-static BOOL deliver_next_report(struct device_extension *ext, IRP *irp)
+static void complete_read_irp(struct device_extension *ext, IRP *irp, const BYTE *buffer, ULONG length)
 {
-    struct hid_report *report;
-    struct list *entry;
     ULONG i;
 
-    if (!(entry = list_head(&ext->reports))) return FALSE;
-    report = LIST_ENTRY(entry, struct hid_report, entry);
-    list_remove(&report->entry);
-
-    memcpy(irp->UserBuffer, report->buffer, report->length);
-    irp->IoStatus.Information = report->length;
+    memcpy(irp->UserBuffer, buffer, length);
+    irp->IoStatus.Information = length;
     irp->IoStatus.Status = STATUS_SUCCESS;
 
     if (TRACE_ON(hid))
     {
-        TRACE("device %p/%#I64x input report length %lu:\n", ext->device, ext->unix_device, report->length);
-        for (i = 0; i < report->length;)
+        TRACE("device %p/%#I64x input report length %lu:\n", ext->device, ext->unix_device, length);
+        for (i = 0; i < length;)
         {
-            char buffer[256], *buf = buffer;
-            buf += sprintf(buf, "%08lx ", i);
-            do { buf += sprintf(buf, " %02x", report->buffer[i]); }
-            while (++i % 16 && i < report->length);
-            TRACE("%s\n", buffer);
+            char buf[256], *ptr = buf;
+            ptr += sprintf(ptr, "%08lx ", i);
+            do { ptr += sprintf(ptr, " %02x", buffer[i]); }
+            while (++i % 16 && i < length);
+            TRACE("%s\n", buf);
         }
     }
+}
+
+static BOOL deliver_next_report(struct device_extension *ext, IRP *irp)
+{
+    struct hid_report *report;
+    struct list *entry;
 
+    if (!(entry = list_head(&ext->reports))) return FALSE;
+    report = LIST_ENTRY(entry, struct hid_report, entry);
+    list_remove(&report->entry);
+
+    complete_read_irp(ext, irp, report->buffer, report->length);
     RtlFreeHeap(GetProcessHeap(), 0, report);
     return TRUE;
 }
@@ -452,22 +457,34 @@ static void process_hid_report(DEVICE_OBJECT *device, BYTE *report_buf, DWORD re
     struct hid_report *report, *last_report;
     IRP *irp;
 
-    if (!(report = RtlAllocateHeap(GetProcessHeap(), 0, size))) return;
-    memcpy(report->buffer, report_buf, report_len);
-    report->length = report_len;
-
     RtlEnterCriticalSection(&ext->cs);
-    list_add_tail(&ext->reports, &report->entry);
 
     if (!ext->collection_desc.ReportIDs[0].ReportID) last_report = ext->last_reports[0];
     else last_report = ext->last_reports[report_buf[0]];
     memcpy(last_report->buffer, report_buf, report_len);
 
-    if ((irp = pop_pending_read(ext)))
+    /* hidclass keeps a read pending most of the time, hand the report over
+     * directly instead of going through the queue when nothing is queued */
+    if (list_empty(&ext->reports) && (irp = pop_pending_read(ext)))
     {
-        deliver_next_report(ext, irp);
+        complete_read_irp(ext, irp, report_buf, report_len);
         IoCompleteRequest(irp, IO_NO_INCREMENT);
     }
+    else if (!(report = RtlAllocateHeap(GetProcessHeap(), 0, size)))
+        ERR("failed to allocate report, dropping input\n");
+    else
+    {
+        memcpy(report->buffer, report_buf, report_len);
+        report->length = report_len;
+        list_add_tail(&ext->reports, &report->entry);
+
+        if ((irp = pop_pending_read(ext)))
+        {
+            deliver_next_report(ext, irp);
+            IoCompleteRequest(irp, IO_NO_INCREMENT);
+        }
+    }
+
     RtlLeaveCriticalSection(&ext->cs);
 }
 
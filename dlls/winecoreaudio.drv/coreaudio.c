@@ -720,7 +720,11 @@ static NTSTATUS unix_create_stream(void *args)
     params->result = S_OK;
 
     if (params->share == AUDCLNT_SHAREMODE_SHARED) {
-        params->period = def_period;
+        /* A shared mode period is only requested through IAudioClient3. */
+        if (params->period)
+            params->period = max(min(params->period, def_period), min_period);
+        else
+            params->period = def_period;
         if (params->duration < 3 * params->period)
             params->duration = 3 * params->period;
     } else {
@@ -370,6 +370,183 @@ static void get_physical_device_info(const struct wined3d_adapter_vk *adapter_vk
         VK_CALL(vkGetPhysicalDeviceFeatures(physical_device, &features2->features));
 }
 
+#define WINED3D_VK_PIPELINE_CACHE_MAGIC 0x43504b56u /* "VKPC" */
+
+struct wined3d_pipeline_cache_header_vk
+{
+    uint32_t magic;
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint32_t driver_version;
+    uint8_t uuid[VK_UUID_SIZE];
+    uint32_t data_size;
+    uint32_t reserved;
+};
+
+static void wined3d_device_vk_get_pipeline_cache_header(const struct wined3d_device_vk *device_vk,
+        VkPhysicalDevice physical_device, struct wined3d_pipeline_cache_header_vk *header, size_t data_size)
+{
+    const struct wined3d_vk_info *vk_info = &device_vk->vk_info;
+    VkPhysicalDeviceProperties properties;
+
+    VK_CALL(vkGetPhysicalDeviceProperties(physical_device, &properties));
+
+    memset(header, 0, sizeof(*header));
+    header->magic = WINED3D_VK_PIPELINE_CACHE_MAGIC;
+    header->vendor_id = properties.vendorID;
+    header->device_id = properties.deviceID;
+    header->driver_version = properties.driverVersion;
+    memcpy(header->uuid, properties.pipelineCacheUUID, sizeof(header->uuid));
+    header->data_size = data_size;
+}
+
+static void *wined3d_device_vk_load_pipeline_cache(struct wined3d_device_vk *device_vk,
+        VkPhysicalDevice physical_device, size_t *size)
+{
+    struct wined3d_pipeline_cache_header_vk header, expected;
+    LARGE_INTEGER file_size;
+    void *data = NULL;
+    HANDLE file;
+    DWORD read;
+
+    *size = 0;
+    if ((file = CreateFileW(device_vk->pipeline_cache_path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+            NULL, OPEN_EXISTING, 0, NULL)) == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    wined3d_device_vk_get_pipeline_cache_header(device_vk, physical_device, &expected, 0);
+    if (!GetFileSizeEx(file, &file_size) || !ReadFile(file, &header, sizeof(header), &read, NULL)
+            || read != sizeof(header) || file_size.QuadPart != sizeof(header) + header.data_size
+            || memcmp(&header, &expected, offsetof(struct wined3d_pipeline_cache_header_vk, data_size)))
+    {
+        WARN("Ignoring mismatching pipeline cache %s.\n", debugstr_w(device_vk->pipeline_cache_path));
+        CloseHandle(file);
+        return NULL;
+    }
+
+    if ((data = heap_alloc(header.data_size)) && (!ReadFile(file, data, header.data_size, &read, NULL)
+            || read != header.data_size))
+    {
+        heap_free(data);
+        data = NULL;
+    }
+    CloseHandle(file);
+
+    if (data)
+        *size = header.data_size;
+    return data;
+}
+
+static void wined3d_device_vk_init_pipeline_cache(struct wined3d_device_vk *device_vk,
+        const struct wined3d_adapter_vk *adapter_vk)
+{
+    const struct wined3d_vk_info *vk_info = &device_vk->vk_info;
+    VkPipelineCacheCreateInfo cache_info;
+    WCHAR path[MAX_PATH];
+    char app_name[64];
+    void *data = NULL;
+    size_t size = 0;
+    unsigned int len;
+    VkResult vr;
+
+    if (wined3d_settings.shader_cache && wined3d_get_cache_dir(path, ARRAY_SIZE(path))
+            && wined3d_get_app_name(app_name, ARRAY_SIZE(app_name)))
+    {
+        len = wcslen(path) + strlen(app_name) + ARRAY_SIZE(L"\\.vkcache");
+        if ((device_vk->pipeline_cache_path = heap_calloc(len, sizeof(WCHAR))))
+            swprintf(device_vk->pipeline_cache_path, len, L"%s\\%hs.vkcache", path, app_name);
+    }
+
+    if (device_vk->pipeline_cache_path)
+        data = wined3d_device_vk_load_pipeline_cache(device_vk, adapter_vk->physical_device, &size);
+
+    cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cache_info.pNext = NULL;
+    cache_info.flags = 0;
+    cache_info.initialDataSize = size;
+    cache_info.pInitialData = data;
+    if ((vr = VK_CALL(vkCreatePipelineCache(device_vk->vk_device, &cache_info, NULL,
+            &device_vk->vk_pipeline_cache))) < 0 && data)
+    {
+        WARN("Failed to create pipeline cache from stored data, vr %s.\n", wined3d_debug_vkresult(vr));
+        cache_info.initialDataSize = size = 0;
+        cache_info.pInitialData = NULL;
+        vr = VK_CALL(vkCreatePipelineCache(device_vk->vk_device, &cache_info, NULL, &device_vk->vk_pipeline_cache));
+    }
+    heap_free(data);
+
+    if (vr < 0)
+    {
+        WARN("Failed to create pipeline cache, vr %s.\n", wined3d_debug_vkresult(vr));
+        device_vk->vk_pipeline_cache = VK_NULL_HANDLE;
+        return;
+    }
+
+    TRACE("Loaded %Iu bytes of pipeline cache data.\n", size);
+    device_vk->pipeline_cache_size = size;
+}
+
+static void wined3d_device_vk_store_pipeline_cache(struct wined3d_device_vk *device_vk)
+{
+    const struct wined3d_adapter_vk *adapter_vk = wined3d_adapter_vk_const(device_vk->d.adapter);
+    const struct wined3d_vk_info *vk_info = &device_vk->vk_info;
+    struct wined3d_pipeline_cache_header_vk header;
+    WCHAR tmp_path[MAX_PATH];
+    size_t size = 0;
+    DWORD written;
+    HANDLE file;
+    void *data;
+    VkResult vr;
+    BOOL ret;
+
+    if (!device_vk->pipeline_cache_path
+            || VK_CALL(vkGetPipelineCacheData(device_vk->vk_device, device_vk->vk_pipeline_cache, &size, NULL)) < 0)
+        return;
+
+    /* Pipeline caches only ever grow. */
+    if (!size || size == device_vk->pipeline_cache_size || !(data = heap_alloc(size)))
+        return;
+    if ((vr = VK_CALL(vkGetPipelineCacheData(device_vk->vk_device, device_vk->vk_pipeline_cache, &size, data))) < 0)
+    {
+        WARN("Failed to get pipeline cache data, vr %s.\n", wined3d_debug_vkresult(vr));
+        heap_free(data);
+        return;
+    }
+    wined3d_device_vk_get_pipeline_cache_header(device_vk, adapter_vk->physical_device, &header, size);
+
+    if (swprintf(tmp_path, ARRAY_SIZE(tmp_path), L"%s.%lx", device_vk->pipeline_cache_path, GetCurrentProcessId()) < 0
+            || (file = CreateFileW(tmp_path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, 0, NULL)) == INVALID_HANDLE_VALUE)
+    {
+        heap_free(data);
+        return;
+    }
+    ret = WriteFile(file, &header, sizeof(header), &written, NULL) && written == sizeof(header)
+            && WriteFile(file, data, size, &written, NULL) && written == size;
+    CloseHandle(file);
+    heap_free(data);
+
+    if (!ret || !MoveFileExW(tmp_path, device_vk->pipeline_cache_path, MOVEFILE_REPLACE_EXISTING))
+    {
+        WARN("Failed to store pipeline cache %s.\n", debugstr_w(device_vk->pipeline_cache_path));
+        DeleteFileW(tmp_path);
+        return;
+    }
+
+    TRACE("Stored %Iu bytes of pipeline cache data.\n", size);
+}
+
+static void wined3d_device_vk_cleanup_pipeline_cache(struct wined3d_device_vk *device_vk)
+{
+    const struct wined3d_vk_info *vk_info = &device_vk->vk_info;
+
+    if (device_vk->vk_pipeline_cache)
+    {
+        wined3d_device_vk_store_pipeline_cache(device_vk);
+        VK_CALL(vkDestroyPipelineCache(device_vk->vk_device, device_vk->vk_pipeline_cache, NULL));
+    }
+    heap_free(device_vk->pipeline_cache_path);
+}
+
 static HRESULT adapter_vk_create_device(struct wined3d *wined3d, const struct wined3d_adapter *adapter,
         enum wined3d_device_type device_type, HWND focus_window, unsigned int flags, BYTE surface_alignment,
         const enum wined3d_feature_level *levels, unsigned int level_count,
@@ -453,10 +630,13 @@ static HRESULT adapter_vk_create_device(struct wined3d *wined3d, const struct wi
         goto fail;
     }
 
+    wined3d_device_vk_init_pipeline_cache(device_vk, adapter_vk);
+
     if (FAILED(hr = wined3d_device_init(&device_vk->d, wined3d, adapter->ordinal, device_type, focus_window,
             flags, surface_alignment, levels, level_count, vk_info->supported, device_parent)))
     {
         WARN("Failed to initialize device, hr %#lx.\n", hr);
+        wined3d_device_vk_cleanup_pipeline_cache(device_vk);
         wined3d_allocator_cleanup(&device_vk->allocator);
         goto fail;
     }
@@ -479,6 +659,7 @@ static void adapter_vk_destroy_device(struct wined3d_device *device)
     const struct wined3d_vk_info *vk_info = &device_vk->vk_info;
 
     wined3d_device_cleanup(&device_vk->d);
+    wined3d_device_vk_cleanup_pipeline_cache(device_vk);
     wined3d_allocator_cleanup(&device_vk->allocator);
 
     wined3d_lock_cleanup(&device_vk->allocator_cs);
@@ -2833,7 +2833,13 @@ static void wined3d_allocator_chunk_gl_unmap(struct wined3d_allocator_chunk_gl *
 
     wined3d_allocator_chunk_gl_lock(chunk_gl);
 
-    if (!--chunk_gl->c.map_count)
+    /* Chunks are shared by many short-lived dynamic buffer allocations.
+     * Unmapping the chunk when the last of those is retired would make the
+     * next DISCARD map from the client thread go through the CS to map it
+     * again, so keep it mapped until the chunk is destroyed, as long as the
+     * address space allows. */
+    if (!--chunk_gl->c.map_count
+            && context_gl->c.device->adapter->mapped_size > MAX_PERSISTENT_MAPPED_BYTES)
     {
         wined3d_context_gl_bind_bo(context_gl, GL_PIXEL_UNPACK_BUFFER, chunk_gl->gl_buffer);
         GL_EXTCALL(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
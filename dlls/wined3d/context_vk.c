@@ -315,7 +315,9 @@ void wined3d_allocator_chunk_vk_unmap(struct wined3d_allocator_chunk_vk *chunk_v
 
     wined3d_allocator_chunk_vk_lock(chunk_vk);
 
-    if (--chunk_vk->c.map_count)
+    /* Keep the chunk mapped for subsequent suballocations, unless we're
+     * running out of address space. */
+    if (--chunk_vk->c.map_count || device_vk->d.adapter->mapped_size <= MAX_PERSISTENT_MAPPED_BYTES)
     {
         wined3d_allocator_chunk_vk_unlock(chunk_vk);
         return;
@@ -1735,6 +1737,7 @@ void wined3d_context_vk_cleanup(struct wined3d_context_vk *context_vk)
 
     wined3d_shader_descriptor_writes_vk_cleanup(&context_vk->descriptor_writes);
     wine_rb_destroy(&context_vk->graphics_pipelines, wined3d_context_vk_destroy_graphics_pipeline, context_vk);
+    memset(context_vk->graphics.pipeline_cache, 0, sizeof(context_vk->graphics.pipeline_cache));
     wine_rb_destroy(&context_vk->pipeline_layouts, wined3d_context_vk_destroy_pipeline_layout, context_vk);
     wine_rb_destroy(&context_vk->render_passes, wined3d_context_vk_destroy_render_pass, context_vk);
 
@@ -2083,6 +2086,40 @@ static int wined3d_bo_slab_vk_compare(const void *key, const struct wine_rb_entr
     return wined3d_uint64_compare(k->size, slab->bo.size);
 }
 
+static uint32_t wined3d_hash_dwords(uint32_t hash, const void *data, size_t size)
+{
+    const uint32_t *p = data;
+    size_t i;
+
+    for (i = 0; i < size / sizeof(*p); ++i)
+    {
+        hash ^= p[i];
+        hash *= 0x01000193;
+        hash ^= hash >> 15;
+    }
+
+    return hash;
+}
+
+/* Only hash the parts of the key that usually tell pipelines apart. Equal
+ * keys still have equal hashes, and wined3d_graphics_pipeline_vk_compare()
+ * confirms a match. */
+static uint32_t wined3d_graphics_pipeline_key_vk_hash(const struct wined3d_graphics_pipeline_key_vk *key)
+{
+    uint32_t hash = 0x811c9dc5;
+    unsigned int i;
+
+    for (i = 0; i < key->pipeline_desc.stageCount; ++i)
+        hash = wined3d_hash_dwords(hash, &key->stages[i].module, sizeof(key->stages[i].module));
+    hash = wined3d_hash_dwords(hash, &key->ia_desc.topology, sizeof(key->ia_desc.topology));
+    hash = wined3d_hash_dwords(hash, key->blend_attachments,
+            key->blend_desc.attachmentCount * sizeof(*key->blend_attachments));
+    hash = wined3d_hash_dwords(hash, &key->pipeline_desc.layout, sizeof(key->pipeline_desc.layout));
+    hash = wined3d_hash_dwords(hash, &key->pipeline_desc.renderPass, sizeof(key->pipeline_desc.renderPass));
+
+    return hash;
+}
+
 static void wined3d_context_vk_init_graphics_pipeline_key(struct wined3d_context_vk *context_vk)
 {
     struct wined3d_graphics_pipeline_key_vk *key;
@@ -2153,6 +2190,8 @@ static void wined3d_context_vk_init_graphics_pipeline_key(struct wined3d_context
     key->pipeline_desc.pColorBlendState = &key->blend_desc;
     key->pipeline_desc.pDynamicState = &key->dynamic_desc;
     key->pipeline_desc.basePipelineIndex = -1;
+
+    key->hash = wined3d_graphics_pipeline_key_vk_hash(key);
 }
 
 static void wined3d_context_vk_update_rasterisation_state(const struct wined3d_context_vk *context_vk,
@@ -2605,6 +2644,9 @@ static bool wined3d_context_vk_update_graphics_pipeline_key(struct wined3d_conte
         update = true;
     }
 
+    if (update)
+        key->hash = wined3d_graphics_pipeline_key_vk_hash(key);
+
     return update;
 }
 
@@ -3378,21 +3420,33 @@ static VkPipeline wined3d_context_vk_get_graphics_pipeline(struct wined3d_contex
 {
     struct wined3d_device_vk *device_vk = wined3d_device_vk(context_vk->c.device);
     const struct wined3d_vk_info *vk_info = context_vk->vk_info;
-    struct wined3d_graphics_pipeline_vk *pipeline_vk;
+    struct wined3d_graphics_pipeline_vk *pipeline_vk, **cache_entry;
     struct wined3d_graphics_pipeline_key_vk *key;
     struct wine_rb_entry *entry;
     VkResult vr;
 
     key = &context_vk->graphics.pipeline_key_vk;
+
+    /* Applications typically cycle through a small set of pipelines. Check
+     * those with a single comparison before walking the tree. */
+    cache_entry = &context_vk->graphics.pipeline_cache[key->hash % WINED3D_GRAPHICS_PIPELINE_CACHE_SIZE];
+    if ((pipeline_vk = *cache_entry) && pipeline_vk->key.hash == key->hash
+            && !wined3d_graphics_pipeline_vk_compare(key, &pipeline_vk->entry))
+        return pipeline_vk->vk_pipeline;
+
     if ((entry = wine_rb_get(&context_vk->graphics_pipelines, key)))
-        return WINE_RB_ENTRY_VALUE(entry, struct wined3d_graphics_pipeline_vk, entry)->vk_pipeline;
+    {
+        pipeline_vk = WINE_RB_ENTRY_VALUE(entry, struct wined3d_graphics_pipeline_vk, entry);
+        *cache_entry = pipeline_vk;
+        return pipeline_vk->vk_pipeline;
+    }
 
     if (!(pipeline_vk = heap_alloc(sizeof(*pipeline_vk))))
         return VK_NULL_HANDLE;
     pipeline_vk->key = *key;
 
     if ((vr = VK_CALL(vkCreateGraphicsPipelines(device_vk->vk_device,
-            VK_NULL_HANDLE, 1, &key->pipeline_desc, NULL, &pipeline_vk->vk_pipeline))) < 0)
+            device_vk->vk_pipeline_cache, 1, &key->pipeline_desc, NULL, &pipeline_vk->vk_pipeline))) < 0)
     {
         WARN("Failed to create graphics pipeline, vr %s.\n", wined3d_debug_vkresult(vr));
         heap_free(pipeline_vk);
@@ -3401,6 +3455,8 @@ static VkPipeline wined3d_context_vk_get_graphics_pipeline(struct wined3d_contex
 
     if (wine_rb_put(&context_vk->graphics_pipelines, &pipeline_vk->key, &pipeline_vk->entry) == -1)
         ERR("Failed to insert pipeline.\n");
+    else
+        *cache_entry = pipeline_vk;
 
     return pipeline_vk->vk_pipeline;
 }
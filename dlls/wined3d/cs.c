@@ -21,6 +21,7 @@
 
 WINE_DEFAULT_DEBUG_CHANNEL(d3d);
 WINE_DECLARE_DEBUG_CHANNEL(d3d_perf);
+WINE_DECLARE_DEBUG_CHANNEL(d3d_stats);
 WINE_DECLARE_DEBUG_CHANNEL(d3d_sync);
 WINE_DECLARE_DEBUG_CHANNEL(fps);
 WINE_DECLARE_DEBUG_CHANNEL(frametime);
@@ -3242,12 +3243,220 @@ static void wined3d_cs_mt_submit(struct wined3d_device_context *context, enum wi
     wined3d_cs_queue_submit(&cs->queue[queue_id], cs);
 }
 
+/* Print a summary every 1.5 seconds, like the fps channel. */
+#define WINED3D_CS_STATS_INTERVAL 1500
+#define WINED3D_CS_TRACE_BUFFER_SIZE 0x10000
+
+struct wined3d_cs_stats
+{
+    LARGE_INTEGER frequency;
+    LONGLONG last_report;
+    LONGLONG busy_time;
+
+    struct
+    {
+        unsigned int count;
+        LONGLONG time;
+    } ops[WINED3D_CS_OP_STOP];
+
+    ULONG max_queue_depth;
+    ULONG64 queue_depth_sum;
+    unsigned int queue_depth_samples;
+
+    /* Accumulated by the application thread. */
+    LONGLONG finish_time, space_time;
+    LONGLONG finish_count, space_count;
+    LONGLONG reported_finish_time, reported_space_time;
+    LONGLONG reported_finish_count, reported_space_count;
+
+    HANDLE trace_file;
+    DWORD pid;
+    bool trace_started;
+    size_t trace_size;
+    char trace_buffer[WINED3D_CS_TRACE_BUFFER_SIZE];
+};
+
+static void wined3d_cs_stats_flush_trace(struct wined3d_cs_stats *stats)
+{
+    DWORD written;
+
+    if (stats->trace_size && !WriteFile(stats->trace_file, stats->trace_buffer, stats->trace_size, &written, NULL))
+        ERR("Failed to write command stream trace, error %lu.\n", GetLastError());
+    stats->trace_size = 0;
+}
+
+static double wined3d_cs_stats_get_us(const struct wined3d_cs_stats *stats, LONGLONG ticks)
+{
+    return ticks * 1000000.0 / stats->frequency.QuadPart;
+}
+
+/* Chrome's "Trace Event Format": one complete ("X") event per command. */
+static void wined3d_cs_stats_trace_op(struct wined3d_cs_stats *stats,
+        enum wined3d_cs_op opcode, LONGLONG start, LONGLONG end)
+{
+    static const size_t prefix_len = sizeof("WINED3D_CS_OP_") - 1;
+    int len;
+
+    if (stats->trace_size > sizeof(stats->trace_buffer) - 256)
+        wined3d_cs_stats_flush_trace(stats);
+
+    len = snprintf(&stats->trace_buffer[stats->trace_size], sizeof(stats->trace_buffer) - stats->trace_size,
+            "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%lu,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+            stats->trace_started ? ",\n" : "", debug_cs_op(opcode) + prefix_len,
+            stats->pid, GetCurrentThreadId(), wined3d_cs_stats_get_us(stats, start),
+            wined3d_cs_stats_get_us(stats, end - start));
+    if (len > 0)
+        stats->trace_size += len;
+    stats->trace_started = true;
+}
+
+static void wined3d_cs_stats_report(struct wined3d_cs_stats *stats, LONGLONG now)
+{
+    LONGLONG finish_time, finish_count, space_time, space_count;
+    double elapsed = (double)(now - stats->last_report);
+    unsigned int i;
+
+    finish_time = InterlockedExchangeAdd64(&stats->finish_time, 0);
+    finish_count = InterlockedExchangeAdd64(&stats->finish_count, 0);
+    space_time = InterlockedExchangeAdd64(&stats->space_time, 0);
+    space_count = InterlockedExchangeAdd64(&stats->space_count, 0);
+
+    TRACE_(d3d_stats)("CS thread busy %.1f%%, queue depth avg %I64u, max %lu bytes.\n",
+            elapsed ? stats->busy_time * 100.0 / elapsed : 0.0,
+            stats->queue_depth_samples ? stats->queue_depth_sum / stats->queue_depth_samples : 0,
+            stats->max_queue_depth);
+    TRACE_(d3d_stats)("Application waited %.3f ms in %I64d finish() calls, %.3f ms in %I64d full queue stalls.\n",
+            wined3d_cs_stats_get_us(stats, finish_time - stats->reported_finish_time) / 1000.0,
+            finish_count - stats->reported_finish_count,
+            wined3d_cs_stats_get_us(stats, space_time - stats->reported_space_time) / 1000.0,
+            space_count - stats->reported_space_count);
+
+    for (i = 0; i < ARRAY_SIZE(stats->ops); ++i)
+    {
+        if (!stats->ops[i].count)
+            continue;
+        TRACE_(d3d_stats)("    %-42s %8u calls, %10.3f ms, %8.3f us/call.\n", debug_cs_op(i),
+                stats->ops[i].count, wined3d_cs_stats_get_us(stats, stats->ops[i].time) / 1000.0,
+                wined3d_cs_stats_get_us(stats, stats->ops[i].time) / stats->ops[i].count);
+    }
+
+    memset(stats->ops, 0, sizeof(stats->ops));
+    stats->busy_time = 0;
+    stats->max_queue_depth = 0;
+    stats->queue_depth_sum = 0;
+    stats->queue_depth_samples = 0;
+    stats->reported_finish_time = finish_time;
+    stats->reported_finish_count = finish_count;
+    stats->reported_space_time = space_time;
+    stats->reported_space_count = space_count;
+    stats->last_report = now;
+}
+
+static void wined3d_cs_stats_record_op(struct wined3d_cs_stats *stats, const struct wined3d_cs_queue *queue,
+        enum wined3d_cs_op opcode, LONGLONG start, LONGLONG end)
+{
+    ULONG depth = (*(volatile ULONG *)&queue->head - queue->tail) & WINED3D_CS_QUEUE_MASK;
+
+    ++stats->ops[opcode].count;
+    stats->ops[opcode].time += end - start;
+    stats->busy_time += end - start;
+
+    stats->max_queue_depth = max(stats->max_queue_depth, depth);
+    stats->queue_depth_sum += depth;
+    ++stats->queue_depth_samples;
+
+    if (stats->trace_file)
+        wined3d_cs_stats_trace_op(stats, opcode, start, end);
+
+    if (TRACE_ON(d3d_stats) && (end - stats->last_report) * 1000
+            > stats->frequency.QuadPart * WINED3D_CS_STATS_INTERVAL)
+        wined3d_cs_stats_report(stats, end);
+}
+
+/* Called by the application thread after spinning on the CS. */
+static void wined3d_cs_stats_add_wait(LONGLONG *time, LONGLONG *count, LONGLONG start)
+{
+    LARGE_INTEGER end;
+
+    QueryPerformanceCounter(&end);
+    InterlockedExchangeAdd64(time, end.QuadPart - start);
+    InterlockedExchangeAdd64(count, 1);
+}
+
+static struct wined3d_cs_stats *wined3d_cs_stats_create(void)
+{
+    struct wined3d_cs_stats *stats;
+    LARGE_INTEGER now;
+    DWORD written;
+
+    if (!TRACE_ON(d3d_stats) && !wined3d_settings.cs_trace_file)
+        return NULL;
+
+    if (!(stats = heap_alloc_zero(sizeof(*stats))))
+        return NULL;
+
+    QueryPerformanceFrequency(&stats->frequency);
+    QueryPerformanceCounter(&now);
+    stats->last_report = now.QuadPart;
+    stats->pid = GetCurrentProcessId();
+
+    if (wined3d_settings.cs_trace_file)
+    {
+        if ((stats->trace_file = CreateFileA(wined3d_settings.cs_trace_file, GENERIC_WRITE,
+                FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL)) == INVALID_HANDLE_VALUE)
+        {
+            ERR("Failed to create command stream trace file %s, error %lu.\n",
+                    debugstr_a(wined3d_settings.cs_trace_file), GetLastError());
+            stats->trace_file = NULL;
+        }
+        else
+        {
+            WriteFile(stats->trace_file, "[\n", 2, &written, NULL);
+        }
+    }
+
+    return stats;
+}
+
+static void wined3d_cs_stats_destroy(struct wined3d_cs_stats *stats)
+{
+    if (!stats)
+        return;
+
+    if (stats->trace_file)
+        CloseHandle(stats->trace_file);
+    heap_free(stats);
+}
+
+/* Called by the CS thread when it stops. */
+static void wined3d_cs_stats_stop(struct wined3d_cs_stats *stats)
+{
+    LARGE_INTEGER now;
+    DWORD written;
+
+    if (TRACE_ON(d3d_stats))
+    {
+        QueryPerformanceCounter(&now);
+        wined3d_cs_stats_report(stats, now.QuadPart);
+    }
+
+    if (stats->trace_file)
+    {
+        wined3d_cs_stats_flush_trace(stats);
+        WriteFile(stats->trace_file, "\n]\n", 3, &written, NULL);
+        CloseHandle(stats->trace_file);
+        stats->trace_file = NULL;
+    }
+}
+
 static void *wined3d_cs_queue_require_space(struct wined3d_cs_queue *queue, size_t size, struct wined3d_cs *cs)
 {
     size_t queue_size = ARRAY_SIZE(queue->data);
     size_t header_size, packet_size, remaining;
     struct wined3d_cs_packet *packet;
     ULONG head = queue->head & WINED3D_CS_QUEUE_MASK;
+    bool waiting = false;
+    LARGE_INTEGER start;
 
     header_size = FIELD_OFFSET(struct wined3d_cs_packet, data[0]);
     packet_size = FIELD_OFFSET(struct wined3d_cs_packet, data[size]);
@@ -3296,8 +3505,16 @@ static void *wined3d_cs_queue_require_space(struct wined3d_cs_queue *queue, size
 
         TRACE_(d3d_perf)("Waiting for free space. Head %lu, tail %lu, packet size %Iu.\n",
                 head, tail, packet_size);
+        if (cs->stats && !waiting)
+        {
+            QueryPerformanceCounter(&start);
+            waiting = true;
+        }
     }
 
+    if (waiting)
+        wined3d_cs_stats_add_wait(&cs->stats->space_time, &cs->stats->space_count, start.QuadPart);
+
     packet = (struct wined3d_cs_packet *)&queue->data[head];
     packet->size = size;
     return packet->data;
@@ -3318,14 +3535,21 @@ static void wined3d_cs_mt_finish(struct wined3d_device_context *context, enum wi
 {
     struct wined3d_cs *cs = wined3d_cs_from_context(context);
     unsigned int spin_count = 0;
+    LARGE_INTEGER start;
 
     if (cs->thread_id == GetCurrentThreadId())
         return wined3d_cs_st_finish(context, queue_id);
 
+    if (cs->stats)
+        QueryPerformanceCounter(&start);
+
     TRACE_(d3d_perf)("Waiting for queue %u to be empty.\n", queue_id);
     while (cs->queue[queue_id].head != *(volatile ULONG *)&cs->queue[queue_id].tail)
         wined3d_pause(&spin_count);
     TRACE_(d3d_perf)("Queue is now empty.\n");
+
+    if (cs->stats && spin_count)
+        wined3d_cs_stats_add_wait(&cs->stats->finish_time, &cs->stats->finish_count, start.QuadPart);
 }
 
 static const struct wined3d_device_context_ops wined3d_cs_mt_ops =
@@ -3418,7 +3642,19 @@ static inline bool wined3d_cs_execute_next(struct wined3d_cs *cs, struct wined3d
         }
 
         wined3d_cs_command_lock(cs);
-        wined3d_cs_op_handlers[opcode](cs, packet->data);
+        if (cs->stats)
+        {
+            LARGE_INTEGER start, end;
+
+            QueryPerformanceCounter(&start);
+            wined3d_cs_op_handlers[opcode](cs, packet->data);
+            QueryPerformanceCounter(&end);
+            wined3d_cs_stats_record_op(cs->stats, queue, opcode, start.QuadPart, end.QuadPart);
+        }
+        else
+        {
+            wined3d_cs_op_handlers[opcode](cs, packet->data);
+        }
         wined3d_cs_command_unlock(cs);
         TRACE("%s at %p executed.\n", debug_cs_op(opcode), packet);
     }
@@ -3506,6 +3742,9 @@ static DWORD WINAPI wined3d_cs_run(void *ctx)
         run = wined3d_cs_execute_next(cs, queue);
     }
 
+    if (cs->stats)
+        wined3d_cs_stats_stop(cs->stats);
+
     cs->queue[WINED3D_CS_QUEUE_MAP].tail = cs->queue[WINED3D_CS_QUEUE_MAP].head;
     cs->queue[WINED3D_CS_QUEUE_DEFAULT].tail = cs->queue[WINED3D_CS_QUEUE_DEFAULT].head;
     TRACE("Stopped.\n");
@@ -3614,9 +3853,12 @@ struct wined3d_cs *wined3d_cs_create(struct wined3d_device *device,
             goto fail;
         }
 
+        cs->stats = wined3d_cs_stats_create();
+
         if (!(cs->thread = CreateThread(NULL, 0, wined3d_cs_run, cs, 0, NULL)))
         {
             ERR("Failed to create wined3d command stream thread.\n");
+            wined3d_cs_stats_destroy(cs->stats);
             FreeLibrary(cs->wined3d_module);
             CloseHandle(cs->present_event);
             if (cs->event)
@@ -3648,6 +3890,7 @@ void wined3d_cs_destroy(struct wined3d_cs *cs)
             ERR("Closing event failed.\n");
     }
 
+    wined3d_cs_stats_destroy(cs->stats);
     wined3d_state_destroy(cs->c.state);
     state_cleanup(&cs->state);
     heap_free(cs->data);
@@ -4501,8 +4744,7 @@ HRESULT CDECL wined3d_deferred_context_record_command_list(struct wined3d_device
     memory = heap_alloc(sizeof(*object) + deferred->resource_count * sizeof(*object->resources)
             + deferred->upload_count * sizeof(*object->uploads)
             + deferred->command_list_count * sizeof(*object->command_lists)
-            + deferred->query_count * sizeof(*object->queries)
-            + deferred->data_size);
+            + deferred->query_count * sizeof(*object->queries));
 
     if (!memory)
     {
@@ -4541,9 +4783,14 @@ HRESULT CDECL wined3d_deferred_context_record_command_list(struct wined3d_device
     memcpy(object->queries, deferred->queries, deferred->query_count * sizeof(*object->queries));
     /* Transfer our references to the queries to the command list. */
 
-    object->data = memory;
+    /* Hand the recorded packets over instead of copying them, shrinking the
+     * buffer to what was recorded. The next recording starts from an empty
+     * buffer, like a new deferred context. */
+    if (!(object->data = heap_realloc(deferred->data, deferred->data_size)))
+        object->data = deferred->data;
     object->data_size = deferred->data_size;
-    memcpy(object->data, deferred->data, deferred->data_size);
+    deferred->data = NULL;
+    deferred->data_capacity = 0;
 
     deferred->data_size = 0;
     deferred->resource_count = 0;
@@ -4607,6 +4854,7 @@ static void wined3d_command_list_destroy_object(void *object)
         }
     }
 
+    heap_free(list->data);
     heap_free(list);
 }
 
@@ -1005,7 +1005,10 @@ static void wined3d_allocator_gl_destroy_chunk(struct wined3d_allocator_chunk *c
 
     wined3d_context_gl_bind_bo(context_gl, GL_PIXEL_UNPACK_BUFFER, chunk_gl->gl_buffer);
     if (chunk_gl->c.map_ptr)
+    {
         GL_EXTCALL(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+        adapter_adjust_mapped_memory(device_gl->d.adapter, -WINED3D_ALLOCATOR_CHUNK_SIZE);
+    }
     GL_EXTCALL(glDeleteBuffers(1, &chunk_gl->gl_buffer));
     TRACE("Freed buffer %u.\n", chunk_gl->gl_buffer);
     wined3d_allocator_chunk_cleanup(&chunk_gl->c);
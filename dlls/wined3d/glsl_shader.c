@@ -123,6 +123,29 @@ struct constant_heap
 };
 
 /* GLSL shader private data */
+#define WINED3D_GLSL_BINARY_MAGIC 0x42534c47u /* "GLSB" */
+
+struct glsl_program_binary_header
+{
+    uint32_t magic;
+    GLenum format;
+    uint32_t size;
+    uint32_t reserved;
+    uint64_t check;
+};
+
+struct glsl_binary_cache
+{
+    BOOL initialised;
+    BOOL enabled;
+    WCHAR path[MAX_PATH];
+    uint64_t driver_hash;
+
+    unsigned int hits;
+    unsigned int misses;
+    unsigned int stores;
+};
+
 struct shader_glsl_priv
 {
     struct wined3d_string_buffer shader_buffer;
@@ -138,6 +161,8 @@ struct shader_glsl_priv
     struct wine_rb_tree ffp_vertex_shaders;
     struct wine_rb_tree ffp_fragment_shaders;
     BOOL legacy_lighting;
+
+    struct glsl_binary_cache binary_cache;
 };
 
 struct glsl_vs_program
@@ -634,6 +659,245 @@ void shader_glsl_validate_link(const struct wined3d_gl_info *gl_info, GLuint pro
     print_glsl_info_log(gl_info, program, TRUE);
 }
 
+static uint64_t shader_glsl_hash_data(uint64_t hash, const void *data, size_t size)
+{
+    const unsigned char *ptr = data;
+
+    /* 64-bit FNV-1a. */
+    while (size--)
+    {
+        hash ^= *ptr++;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/* Context activation is done by the caller. */
+static void shader_glsl_init_binary_cache(struct glsl_binary_cache *cache, const struct wined3d_gl_info *gl_info)
+{
+    static const GLenum driver_strings[] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    GLint format_count = 0;
+    const char *str;
+    unsigned int i;
+
+    cache->initialised = TRUE;
+
+    if (!wined3d_settings.shader_cache || !gl_info->supported[ARB_GET_PROGRAM_BINARY])
+        return;
+
+    gl_info->gl_ops.gl.p_glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+    if (!format_count)
+    {
+        TRACE("Driver doesn't expose any program binary formats.\n");
+        return;
+    }
+
+    /* Leave room for the file names. */
+    if (!wined3d_get_cache_dir(cache->path, ARRAY_SIZE(cache->path) - 32))
+    {
+        WARN("No usable cache directory, not caching program binaries.\n");
+        return;
+    }
+
+    cache->driver_hash = 0xcbf29ce484222325ull;
+    for (i = 0; i < ARRAY_SIZE(driver_strings); ++i)
+    {
+        if ((str = (const char *)gl_info->gl_ops.gl.p_glGetString(driver_strings[i])))
+            cache->driver_hash = shader_glsl_hash_data(cache->driver_hash, str, strlen(str) + 1);
+    }
+
+    TRACE("Caching program binaries in %s.\n", debugstr_w(cache->path));
+    cache->enabled = TRUE;
+}
+
+/* Context activation is done by the caller. */
+static BOOL shader_glsl_get_program_key(const struct wined3d_gl_info *gl_info, GLuint program,
+        const struct glsl_binary_cache *cache, uint32_t flags, uint64_t *key, uint64_t *check)
+{
+    GLint i, shader_count, type, length, source_size = 0;
+    uint64_t key_hash, check_hash;
+    char *source = NULL;
+    GLuint *shaders;
+
+    /* The key names the cache file, the second hash, computed with a
+     * different basis, guards against collisions between different
+     * programs. */
+    key_hash = shader_glsl_hash_data(cache->driver_hash, &flags, sizeof(flags));
+    check_hash = shader_glsl_hash_data(~cache->driver_hash, &flags, sizeof(flags));
+
+    GL_EXTCALL(glGetProgramiv(program, GL_ATTACHED_SHADERS, &shader_count));
+    if (!shader_count || !(shaders = heap_calloc(shader_count, sizeof(*shaders))))
+        return FALSE;
+
+    GL_EXTCALL(glGetAttachedShaders(program, shader_count, NULL, shaders));
+    for (i = 0; i < shader_count; ++i)
+    {
+        GL_EXTCALL(glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type));
+        GL_EXTCALL(glGetShaderiv(shaders[i], GL_SHADER_SOURCE_LENGTH, &length));
+        if (source_size < length)
+        {
+            heap_free(source);
+            if (!(source = heap_alloc(length)))
+            {
+                heap_free(shaders);
+                return FALSE;
+            }
+            source_size = length;
+        }
+        if (length)
+            GL_EXTCALL(glGetShaderSource(shaders[i], length, NULL, source));
+
+        key_hash = shader_glsl_hash_data(key_hash, &type, sizeof(type));
+        key_hash = shader_glsl_hash_data(key_hash, source, length);
+        check_hash = shader_glsl_hash_data(check_hash, &type, sizeof(type));
+        check_hash = shader_glsl_hash_data(check_hash, source, length);
+    }
+    checkGLcall("get program sources");
+
+    heap_free(source);
+    heap_free(shaders);
+
+    *key = key_hash;
+    *check = check_hash;
+    return TRUE;
+}
+
+/* Context activation is done by the caller. */
+static BOOL shader_glsl_load_program_binary(const struct wined3d_gl_info *gl_info,
+        GLuint program, const WCHAR *path, uint64_t check)
+{
+    struct glsl_program_binary_header header;
+    GLint status = GL_FALSE;
+    void *data = NULL;
+    DWORD size;
+    HANDLE file;
+
+    if ((file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+            NULL, OPEN_EXISTING, 0, NULL)) == INVALID_HANDLE_VALUE)
+        return FALSE;
+
+    if (!ReadFile(file, &header, sizeof(header), &size, NULL) || size != sizeof(header)
+            || header.magic != WINED3D_GLSL_BINARY_MAGIC || header.check != check || !header.size)
+    {
+        WARN("Ignoring mismatching program binary %s.\n", debugstr_w(path));
+        CloseHandle(file);
+        return FALSE;
+    }
+
+    if ((data = heap_alloc(header.size)) && ReadFile(file, data, header.size, &size, NULL)
+            && size == header.size)
+    {
+        GL_EXTCALL(glProgramBinary(program, header.format, data, header.size));
+        checkGLcall("glProgramBinary");
+        GL_EXTCALL(glGetProgramiv(program, GL_LINK_STATUS, &status));
+    }
+    heap_free(data);
+    CloseHandle(file);
+
+    if (!status)
+    {
+        /* Typically a driver update; the program will be linked and stored
+         * again by the caller. */
+        TRACE("Program binary %s was rejected.\n", debugstr_w(path));
+        DeleteFileW(path);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/* Context activation is done by the caller. */
+static BOOL shader_glsl_store_program_binary(const struct wined3d_gl_info *gl_info,
+        GLuint program, const WCHAR *path, uint64_t check)
+{
+    struct glsl_program_binary_header header;
+    WCHAR tmp_path[MAX_PATH];
+    GLint status, size = 0;
+    GLsizei length = 0;
+    DWORD written;
+    HANDLE file;
+    void *data;
+    BOOL ret;
+
+    GL_EXTCALL(glGetProgramiv(program, GL_LINK_STATUS, &status));
+    if (!status)
+        return FALSE;
+    GL_EXTCALL(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size));
+    if (size <= 0 || !(data = heap_alloc(size)))
+        return FALSE;
+
+    GL_EXTCALL(glGetProgramBinary(program, size, &length, &header.format, data));
+    checkGLcall("glGetProgramBinary");
+    if (length <= 0)
+    {
+        heap_free(data);
+        return FALSE;
+    }
+    header.magic = WINED3D_GLSL_BINARY_MAGIC;
+    header.size = length;
+    header.reserved = 0;
+    header.check = check;
+
+    /* Write to a temporary file first, so that concurrent processes never
+     * see a partially written binary. */
+    swprintf(tmp_path, ARRAY_SIZE(tmp_path), L"%s.%lx", path, GetCurrentProcessId());
+    if ((file = CreateFileW(tmp_path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, 0, NULL)) == INVALID_HANDLE_VALUE)
+    {
+        heap_free(data);
+        return FALSE;
+    }
+    ret = WriteFile(file, &header, sizeof(header), &written, NULL) && written == sizeof(header)
+            && WriteFile(file, data, length, &written, NULL) && written == length;
+    CloseHandle(file);
+    heap_free(data);
+
+    if (!ret || !MoveFileExW(tmp_path, path, MOVEFILE_REPLACE_EXISTING))
+    {
+        WARN("Failed to store program binary %s.\n", debugstr_w(path));
+        DeleteFileW(tmp_path);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/* Context activation is done by the caller. */
+static void shader_glsl_link_program(struct shader_glsl_priv *priv, const struct wined3d_gl_info *gl_info,
+        GLuint program, uint32_t flags, BOOL cacheable)
+{
+    struct glsl_binary_cache *cache = &priv->binary_cache;
+    WCHAR path[MAX_PATH];
+    uint64_t key, check;
+
+    if (!cache->initialised)
+        shader_glsl_init_binary_cache(cache, gl_info);
+
+    if (!cache->enabled || !cacheable || !shader_glsl_get_program_key(gl_info, program, cache, flags, &key, &check))
+    {
+        GL_EXTCALL(glLinkProgram(program));
+        shader_glsl_validate_link(gl_info, program);
+        return;
+    }
+
+    swprintf(path, ARRAY_SIZE(path), L"%s\\%08x%08x.bin", cache->path,
+            (unsigned int)(key >> 32), (unsigned int)key);
+
+    if (shader_glsl_load_program_binary(gl_info, program, path, check))
+    {
+        TRACE("Loaded program %u from %s.\n", program, debugstr_w(path));
+        ++cache->hits;
+        return;
+    }
+    ++cache->misses;
+
+    GL_EXTCALL(glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    GL_EXTCALL(glLinkProgram(program));
+    shader_glsl_validate_link(gl_info, program);
+
+    if (shader_glsl_store_program_binary(gl_info, program, path, check))
+        ++cache->stores;
+}
+
 static BOOL shader_glsl_use_layout_qualifier(const struct wined3d_gl_info *gl_info)
 {
     /* Layout qualifiers were introduced in GLSL 1.40. The Nvidia Legacy GPU
@@ -10204,8 +10468,7 @@ static HRESULT shader_glsl_compile_compute_shader(struct shader_glsl_priv *priv,
     list_add_head(&shader->linked_programs, &entry->cs.shader_entry);
 
     TRACE("Linking GLSL shader program %u.\n", program_id);
-    GL_EXTCALL(glLinkProgram(program_id));
-    shader_glsl_validate_link(gl_info, program_id);
+    shader_glsl_link_program(priv, gl_info, program_id, 0, TRUE);
 
     GL_EXTCALL(glUseProgram(program_id));
     checkGLcall("glUseProgram");
@@ -10533,10 +10796,12 @@ static void set_glsl_shader_program(const struct wined3d_context_gl *context_gl,
         list_add_head(ps_list, &entry->ps.shader_entry);
     }
 
-    /* Link the program */
+    /* Link the program. Stream output varyings aren't part of the cache
+     * key, so don't cache programs using them. */
     TRACE("Linking GLSL shader program %u.\n", program_id);
-    GL_EXTCALL(glLinkProgram(program_id));
-    shader_glsl_validate_link(gl_info, program_id);
+    shader_glsl_link_program(priv, gl_info, program_id,
+            state->blend_state && state->blend_state->dual_source,
+            !gshader || !gshader->u.gs.so_desc);
 
     shader_glsl_init_vs_uniform_locations(gl_info, priv, program_id, &entry->vs,
             vshader ? vshader->limits->constant_float : 0);
@@ -11149,6 +11414,10 @@ static void shader_glsl_free(struct wined3d_device *device, struct wined3d_conte
 {
     struct shader_glsl_priv *priv = device->shader_priv;
 
+    if (priv->binary_cache.enabled)
+        TRACE("Program binary cache: %u hits, %u misses, %u stores.\n",
+                priv->binary_cache.hits, priv->binary_cache.misses, priv->binary_cache.stores);
+
     wine_rb_destroy(&priv->program_lookup, NULL, NULL);
     constant_heap_free(&priv->pconst_heap);
     constant_heap_free(&priv->vconst_heap);
@@ -29,6 +29,10 @@
 #include "wined3d_private.h"
 #include "wined3d_gl.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 WINE_DEFAULT_DEBUG_CHANNEL(d3d);
 WINE_DECLARE_DEBUG_CHANNEL(d3d_perf);
 
@@ -82,6 +86,14 @@ static void convert_r5g6b5_x8r8g8b8(const BYTE *src, BYTE *dst,
         0xe3, 0xe7, 0xeb, 0xef, 0xf3, 0xf7, 0xfb, 0xff,
     };
     unsigned int x, y;
+#if defined(__SSE2__)
+    /* convert_5to8[i] == (i * 527 + 23) >> 6 and
+     * convert_6to8[i] == (i * 259 + 33) >> 6 for all inputs. */
+    const __m128i mul5 = _mm_set1_epi16(527), add5 = _mm_set1_epi16(23);
+    const __m128i mul6 = _mm_set1_epi16(259), add6 = _mm_set1_epi16(33);
+    const __m128i mask5 = _mm_set1_epi16(0x1f), mask6 = _mm_set1_epi16(0x3f);
+    const __m128i alpha = _mm_set1_epi16(0xff00);
+#endif
 
     TRACE("Converting %ux%u pixels, pitches %u %u.\n", w, h, pitch_in, pitch_out);
 
@@ -89,7 +101,29 @@ static void convert_r5g6b5_x8r8g8b8(const BYTE *src, BYTE *dst,
     {
         const WORD *src_line = (const WORD *)(src + y * pitch_in);
         DWORD *dst_line = (DWORD *)(dst + y * pitch_out);
-        for (x = 0; x < w; ++x)
+
+        x = 0;
+#if defined(__SSE2__)
+        for (; x + 8 <= w; x += 8)
+        {
+            __m128i pixel = _mm_loadu_si128((const __m128i *)&src_line[x]);
+            __m128i r, g, b, gb, ar;
+
+            r = _mm_srli_epi16(pixel, 11);
+            g = _mm_and_si128(_mm_srli_epi16(pixel, 5), mask6);
+            b = _mm_and_si128(pixel, mask5);
+
+            r = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(r, mul5), add5), 6);
+            g = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(g, mul6), add6), 6);
+            b = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(b, mul5), add5), 6);
+
+            gb = _mm_or_si128(_mm_slli_epi16(g, 8), b);
+            ar = _mm_or_si128(alpha, r);
+            _mm_storeu_si128((__m128i *)&dst_line[x], _mm_unpacklo_epi16(gb, ar));
+            _mm_storeu_si128((__m128i *)&dst_line[x + 4], _mm_unpackhi_epi16(gb, ar));
+        }
+#endif
+        for (; x < w; ++x)
         {
             WORD pixel = src_line[x];
             dst_line[x] = 0xff000000u
@@ -106,6 +140,9 @@ static void convert_a8r8g8b8_x8r8g8b8(const BYTE *src, BYTE *dst,
         unsigned int pitch_in, unsigned int pitch_out, unsigned int w, unsigned int h)
 {
     unsigned int x, y;
+#if defined(__SSE2__)
+    const __m128i alpha = _mm_set1_epi32(0xff000000);
+#endif
 
     TRACE("Converting %ux%u pixels, pitches %u %u.\n", w, h, pitch_in, pitch_out);
 
@@ -114,7 +151,16 @@ static void convert_a8r8g8b8_x8r8g8b8(const BYTE *src, BYTE *dst,
         const DWORD *src_line = (const DWORD *)(src + y * pitch_in);
         DWORD *dst_line = (DWORD *)(dst + y * pitch_out);
 
-        for (x = 0; x < w; ++x)
+        x = 0;
+#if defined(__SSE2__)
+        for (; x + 4 <= w; x += 4)
+        {
+            __m128i pixel = _mm_loadu_si128((const __m128i *)&src_line[x]);
+
+            _mm_storeu_si128((__m128i *)&dst_line[x], _mm_or_si128(pixel, alpha));
+        }
+#endif
+        for (; x < w; ++x)
         {
             dst_line[x] = 0xff000000 | (src_line[x] & 0xffffff);
         }
@@ -440,69 +440,77 @@ static void decompress_dxtn_block(const BYTE *src, BYTE *dst, unsigned int width
         unsigned int height, unsigned int dst_row_pitch, enum wined3d_format_id format_id)
 {
     const UINT64 *s = (const UINT64 *)src;
-    BOOL bc1_alpha = FALSE;
     DWORD colour_table[4];
     BYTE alpha_table[8];
     UINT64 alpha_bits;
     DWORD colour_bits;
     unsigned int x, y;
-    BYTE colour_idx;
     DWORD *dst_row;
-    BYTE alpha;
 
+    /* The format checks are hoisted out of the pixel loops; the alpha is
+     * either folded into the colour table (BC1), or looked up per pixel. */
     if (format_id == WINED3DFMT_BC1_UNORM)
     {
         WORD colour0, colour1;
 
-        alpha_bits = 0;
-
         colour0 = s[0] & 0xffff;
         colour1 = (s[0] >> 16) & 0xffff;
         colour_bits = (s[0] >> 32) & 0xffffffff;
         build_dxtn_colour_table(colour0, colour1, colour_table, format_id);
+        for (x = 0; x < 4; ++x)
+            colour_table[x] |= 0xff000000;
         if (colour0 <= colour1)
-            bc1_alpha = TRUE;
-    }
-    else
-    {
-        alpha_bits = s[0];
-        if (format_id == WINED3DFMT_BC3_UNORM)
+            colour_table[3] &= 0x00ffffff;
+
+        for (y = 0; y < height; ++y, colour_bits >>= 8)
         {
-            build_bc3_alpha_table(alpha_bits & 0xff, (alpha_bits >> 8) & 0xff, alpha_table);
-            alpha_bits >>= 16;
+            dst_row = (DWORD *)&dst[y * dst_row_pitch];
+            for (x = 0; x < width; ++x)
+                dst_row[x] = colour_table[(colour_bits >> (x * 2)) & 0x3];
         }
-
-        colour_bits = (s[1] >> 32) & 0xffffffff;
-        build_dxtn_colour_table(s[1] & 0xffff, (s[1] >> 16) & 0xffff, colour_table, format_id);
+        return;
     }
 
-    for (y = 0; y < height; ++y)
+    alpha_bits = s[0];
+    colour_bits = (s[1] >> 32) & 0xffffffff;
+    build_dxtn_colour_table(s[1] & 0xffff, (s[1] >> 16) & 0xffff, colour_table, format_id);
+
+    if (format_id == WINED3DFMT_BC2_UNORM)
     {
-        dst_row = (DWORD *)&dst[y * dst_row_pitch];
-        for (x = 0; x < width; ++x)
+        for (y = 0; y < height; ++y, colour_bits >>= 8, alpha_bits >>= 16)
         {
-            colour_idx = (colour_bits >> (y * 8 + x * 2)) & 0x3;
-            switch (format_id)
+            dst_row = (DWORD *)&dst[y * dst_row_pitch];
+            for (x = 0; x < width; ++x)
             {
-                case WINED3DFMT_BC1_UNORM:
-                    alpha = bc1_alpha && colour_idx == 3 ? 0x00 : 0xff;
-                    break;
-
-                case WINED3DFMT_BC2_UNORM:
-                    alpha = (alpha_bits >> (y * 16 + x * 4)) & 0xf;
-                    /* (2⁸ - 1) / (2⁴ - 1) ≈ 2⁸ / 2⁴ + 2⁸ / 2⁸ */
-                    alpha |= alpha << 4;
-                    break;
+                /* (2⁸ - 1) / (2⁴ - 1) ≈ 2⁸ / 2⁴ + 2⁸ / 2⁸ */
+                DWORD alpha = ((alpha_bits >> (x * 4)) & 0xf) * 0x11;
 
-                case WINED3DFMT_BC3_UNORM:
-                    alpha = alpha_table[(alpha_bits >> (y * 12 + x * 3)) & 0x7];
-                    break;
+                dst_row[x] = (alpha << 24) | colour_table[(colour_bits >> (x * 2)) & 0x3];
+            }
+        }
+    }
+    else if (format_id == WINED3DFMT_BC3_UNORM)
+    {
+        build_bc3_alpha_table(alpha_bits & 0xff, (alpha_bits >> 8) & 0xff, alpha_table);
+        alpha_bits >>= 16;
 
-                default:
-                    alpha = 0xff;
-                    break;
+        for (y = 0; y < height; ++y, colour_bits >>= 8, alpha_bits >>= 12)
+        {
+            dst_row = (DWORD *)&dst[y * dst_row_pitch];
+            for (x = 0; x < width; ++x)
+            {
+                dst_row[x] = ((DWORD)alpha_table[(alpha_bits >> (x * 3)) & 0x7] << 24)
+                        | colour_table[(colour_bits >> (x * 2)) & 0x3];
             }
-            dst_row[x] = (alpha << 24) | colour_table[colour_idx];
+        }
+    }
+    else
+    {
+        for (y = 0; y < height; ++y, colour_bits >>= 8)
+        {
+            dst_row = (DWORD *)&dst[y * dst_row_pitch];
+            for (x = 0; x < width; ++x)
+                dst_row[x] = 0xff000000 | colour_table[(colour_bits >> (x * 2)) & 0x3];
         }
     }
 }
@@ -132,6 +132,7 @@ struct wined3d_settings wined3d_settings =
     .max_sm_cs = UINT_MAX,
     .renderer = WINED3D_RENDERER_AUTO,
     .shader_backend = WINED3D_SHADER_BACKEND_AUTO,
+    .shader_cache = TRUE,
 };
 
 enum wined3d_renderer CDECL wined3d_get_renderer(void)
@@ -265,6 +266,28 @@ BOOL wined3d_get_app_name(char *app_name, unsigned int app_name_size)
     return TRUE;
 }
 
+/* Persistent shader and pipeline caches live in the prefix, so that they
+ * survive between runs. */
+BOOL wined3d_get_cache_dir(WCHAR *path, unsigned int size)
+{
+    unsigned int len;
+
+    len = GetEnvironmentVariableW(L"LOCALAPPDATA", path, size);
+    if (!len || len + wcslen(L"\\wine\\wined3d") >= size)
+        return FALSE;
+
+    wcscat(path, L"\\wine");
+    CreateDirectoryW(path, NULL);
+    wcscat(path, L"\\wined3d");
+    if (!CreateDirectoryW(path, NULL) && GetLastError() != ERROR_ALREADY_EXISTS)
+    {
+        WARN("Failed to create cache directory %s, error %lu.\n", debugstr_w(path), GetLastError());
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
 static void vkd3d_log_callback(const char *fmt, va_list args)
 {
     char buffer[1024];
@@ -480,6 +503,18 @@ static BOOL wined3d_dll_init(HINSTANCE hInstDLL)
             TRACE("Forcing all constant buffers to be write-mappable.\n");
             wined3d_settings.cb_access_map_w = TRUE;
         }
+        if (!get_config_key_dword(hkey, appkey, env, "shader_cache", &wined3d_settings.shader_cache)
+                && !wined3d_settings.shader_cache)
+            TRACE("Disabling persistent shader caches.\n");
+        if (!get_config_key(hkey, appkey, env, "cs_trace_file", buffer, size))
+        {
+            size_t len = strlen(buffer) + 1;
+
+            if (!(wined3d_settings.cs_trace_file = heap_alloc(len)))
+                ERR("Failed to allocate command stream trace path memory.\n");
+            else
+                memcpy(wined3d_settings.cs_trace_file, buffer, len);
+        }
     }
 
     if (appkey) RegCloseKey( appkey );
@@ -539,6 +574,7 @@ static BOOL wined3d_dll_destroy(HINSTANCE hInstDLL)
     heap_free(swapchain_state_table.hooks);
 
     heap_free(wined3d_settings.logo);
+    heap_free(wined3d_settings.cs_trace_file);
     UnregisterClassA(WINED3D_OPENGL_WINDOW_CLASS_NAME, hInstDLL);
 
     DeleteCriticalSection(&wined3d_command_cs);
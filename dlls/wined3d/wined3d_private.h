@@ -485,6 +485,8 @@ struct wined3d_settings
     enum wined3d_renderer renderer;
     enum wined3d_shader_backend shader_backend;
     BOOL cb_access_map_w;
+    unsigned int shader_cache;
+    char *cs_trace_file;
 };
 
 extern struct wined3d_settings wined3d_settings;
@@ -2791,6 +2793,7 @@ BOOL wined3d_get_inside_mode_change(HWND window);
 BOOL wined3d_set_inside_mode_change(HWND window, BOOL inside_mode_change);
 
 BOOL wined3d_get_app_name(char *app_name, unsigned int app_name_size);
+BOOL wined3d_get_cache_dir(WCHAR *path, unsigned int size);
 
 enum wined3d_push_constants
 {
@@ -3626,6 +3629,8 @@ struct wined3d_cs
     LONG waiting_for_event;
     LONG waiting_for_present;
     LONG pending_presents;
+
+    struct wined3d_cs_stats *stats;
 };
 
 static inline void wined3d_device_context_lock(struct wined3d_device_context *context)
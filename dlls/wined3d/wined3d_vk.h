@@ -512,8 +512,12 @@ struct wined3d_graphics_pipeline_key_vk
     VkPipelineDynamicStateCreateInfo dynamic_desc;
 
     VkGraphicsPipelineCreateInfo pipeline_desc;
+
+    uint32_t hash;
 };
 
+#define WINED3D_GRAPHICS_PIPELINE_CACHE_SIZE 64
+
 struct wined3d_graphics_pipeline_vk
 {
     struct wine_rb_entry entry;
@@ -566,6 +570,8 @@ struct wined3d_context_vk
     {
         VkShaderModule vk_modules[WINED3D_SHADER_TYPE_GRAPHICS_COUNT];
         struct wined3d_graphics_pipeline_key_vk pipeline_key_vk;
+        /* Recently used pipelines, indexed by key hash. */
+        struct wined3d_graphics_pipeline_vk *pipeline_cache[WINED3D_GRAPHICS_PIPELINE_CACHE_SIZE];
         VkPipeline vk_pipeline;
         VkPipelineLayout vk_pipeline_layout;
         VkDescriptorSetLayout vk_set_layout;
@@ -800,6 +806,10 @@ struct wined3d_device_vk
     struct wined3d_allocator allocator;
 
     struct wined3d_uav_clear_state_vk uav_clear_state;
+
+    VkPipelineCache vk_pipeline_cache;
+    WCHAR *pipeline_cache_path;
+    size_t pipeline_cache_size;
 };
 
 static inline struct wined3d_device_vk *wined3d_device_vk(struct wined3d_device *device)
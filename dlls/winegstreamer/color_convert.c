@@ -88,6 +88,8 @@ struct color_convert
 
     wg_transform_t wg_transform;
     struct wg_sample_queue *wg_sample_queue;
+    struct video_convert video_convert;
+    bool use_video_convert;
 };
 
 static inline struct color_convert *impl_from_IUnknown(IUnknown *iface)
@@ -103,6 +105,8 @@ static HRESULT try_create_wg_transform(struct color_convert *impl)
     if (impl->wg_transform)
         wg_transform_destroy(impl->wg_transform);
     impl->wg_transform = 0;
+    impl->use_video_convert = false;
+    video_convert_cleanup(&impl->video_convert);
 
     mf_media_type_to_wg_format(impl->input_type, &input_format);
     if (input_format.major_type == WG_MAJOR_TYPE_UNKNOWN)
@@ -115,6 +119,8 @@ static HRESULT try_create_wg_transform(struct color_convert *impl)
     if (!(impl->wg_transform = wg_transform_create(&input_format, &output_format, &attrs)))
         return E_FAIL;
 
+    /* convert the most common formats directly, avoiding the GStreamer round trip */
+    impl->use_video_convert = video_convert_init(&impl->video_convert, &input_format, &output_format);
     return S_OK;
 }
 
@@ -166,6 +172,7 @@ static ULONG WINAPI unknown_Release(IUnknown *iface)
     {
         if (impl->wg_transform)
             wg_transform_destroy(impl->wg_transform);
+        video_convert_cleanup(&impl->video_convert);
         if (impl->input_type)
             IMFMediaType_Release(impl->input_type);
         if (impl->output_type)
@@ -566,6 +573,8 @@ static HRESULT WINAPI transform_ProcessInput(IMFTransform *iface, DWORD id, IMFS
     if (!impl->wg_transform)
         return MF_E_TRANSFORM_TYPE_NOT_SET;
 
+    if (impl->use_video_convert)
+        return video_convert_push_mf(&impl->video_convert, sample);
     return wg_transform_push_mf(impl->wg_transform, sample, impl->wg_sample_queue);
 }
 
@@ -588,6 +597,9 @@ static HRESULT WINAPI transform_ProcessOutput(IMFTransform *iface, DWORD flags,
     if (!samples->pSample)
         return E_INVALIDARG;
 
+    if (impl->use_video_convert)
+        return video_convert_read_mf(&impl->video_convert, samples->pSample);
+
     if (FAILED(hr = IMFTransform_GetOutputStreamInfo(iface, 0, &info)))
         return hr;
 
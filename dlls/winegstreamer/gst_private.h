@@ -165,6 +165,20 @@ HRESULT wg_transform_read_mf(wg_transform_t transform, IMFSample *sample,
 HRESULT wg_transform_read_quartz(wg_transform_t transform, struct wg_sample *sample);
 HRESULT wg_transform_read_dmo(wg_transform_t transform, DMO_OUTPUT_DATA_BUFFER *buffer);
 
+struct video_convert
+{
+    enum wg_video_format input_format;
+    UINT32 width, height;
+    bool flip;
+    IMFSample *sample;
+};
+
+bool video_convert_init(struct video_convert *convert, const struct wg_format *input_format,
+        const struct wg_format *output_format);
+void video_convert_cleanup(struct video_convert *convert);
+HRESULT video_convert_push_mf(struct video_convert *convert, IMFSample *sample);
+HRESULT video_convert_read_mf(struct video_convert *convert, IMFSample *sample);
+
 HRESULT gstreamer_byte_stream_handler_create(REFIID riid, void **obj);
 
 unsigned int wg_format_get_stride(const struct wg_format *format);
@@ -0,0 +1,328 @@
+/*
+ * Native YUV to RGB conversion for the video transforms
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include "gst_private.h"
+
+#include "mfapi.h"
+#include "mferror.h"
+
+#include "wine/debug.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+WINE_DEFAULT_DEBUG_CHANNEL(mfplat);
+
+/* Limited range YUV to RGB coefficients, with 6 fractional bits. The luma
+ * factor is 74.5 and is applied as y * 74 + y / 2. */
+static const struct yuv_matrix
+{
+    short rv, gu, gv, bu;
+}
+bt601_matrix = {102, 25, 52, 129},
+bt709_matrix = {115, 14, 34, 135};
+
+static inline BYTE clamp_pixel(int value)
+{
+    value >>= 6;
+    return value < 0 ? 0 : value > 255 ? 255 : value;
+}
+
+static inline void yuv_to_bgra(BYTE *dst, int y, int u, int v, const struct yuv_matrix *m)
+{
+    y = (y - 16) * 74 + ((y - 16) >> 1) + 32;
+    u -= 128;
+    v -= 128;
+
+    dst[0] = clamp_pixel(y + m->bu * u);
+    dst[1] = clamp_pixel(y - m->gu * u - m->gv * v);
+    dst[2] = clamp_pixel(y + m->rv * v);
+    dst[3] = 0xff;
+}
+
+#if defined(__SSE2__)
+
+/* y, u and v hold 8 biased 16-bit samples each, chroma already duplicated for every pixel. */
+static inline void yuv_to_bgra_sse2(BYTE *dst, __m128i y, __m128i u, __m128i v, const struct yuv_matrix *m)
+{
+    __m128i r, g, b, bg, ra;
+
+    y = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(y, _mm_set1_epi16(74)), _mm_srai_epi16(y, 1)),
+            _mm_set1_epi16(32));
+
+    /* saturation only happens for values which end up clamped to 255 anyway */
+    b = _mm_srai_epi16(_mm_adds_epi16(y, _mm_mullo_epi16(u, _mm_set1_epi16(m->bu))), 6);
+    g = _mm_subs_epi16(y, _mm_mullo_epi16(u, _mm_set1_epi16(m->gu)));
+    g = _mm_srai_epi16(_mm_subs_epi16(g, _mm_mullo_epi16(v, _mm_set1_epi16(m->gv))), 6);
+    r = _mm_srai_epi16(_mm_adds_epi16(y, _mm_mullo_epi16(v, _mm_set1_epi16(m->rv))), 6);
+
+    b = _mm_packus_epi16(b, r);
+    g = _mm_packus_epi16(g, _mm_set1_epi16(0xff));
+    bg = _mm_unpacklo_epi8(b, g);
+    ra = _mm_unpackhi_epi8(b, g);
+    _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(bg, ra));
+    _mm_storeu_si128((__m128i *)dst + 1, _mm_unpackhi_epi16(bg, ra));
+}
+
+/* splits 8 interleaved 16-bit u/v samples and duplicates each of them for two pixels */
+static inline void split_chroma_sse2(__m128i uv, __m128i *u, __m128i *v)
+{
+    __m128i lo = _mm_and_si128(uv, _mm_set1_epi32(0xffff)), hi = _mm_srli_epi32(uv, 16);
+
+    *u = _mm_sub_epi16(_mm_or_si128(lo, _mm_slli_epi32(lo, 16)), _mm_set1_epi16(128));
+    *v = _mm_sub_epi16(_mm_or_si128(hi, _mm_slli_epi32(hi, 16)), _mm_set1_epi16(128));
+}
+
+#endif
+
+static void convert_row_planar(BYTE *dst, const BYTE *y, const BYTE *u, const BYTE *v, UINT32 width,
+        const struct yuv_matrix *m)
+{
+    UINT32 x = 0;
+
+#if defined(__SSE2__)
+    __m128i zero = _mm_setzero_si128(), luma, cb, cr;
+
+    for (; x + 8 <= width; x += 8)
+    {
+        luma = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(y + x)), zero), _mm_set1_epi16(16));
+        cb = _mm_cvtsi32_si128(*(const int *)(u + x / 2));
+        cr = _mm_cvtsi32_si128(*(const int *)(v + x / 2));
+        cb = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_unpacklo_epi8(cb, cb), zero), _mm_set1_epi16(128));
+        cr = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_unpacklo_epi8(cr, cr), zero), _mm_set1_epi16(128));
+        yuv_to_bgra_sse2(dst + x * 4, luma, cb, cr, m);
+    }
+#endif
+
+    for (; x < width; x++)
+        yuv_to_bgra(dst + x * 4, y[x], u[x / 2], v[x / 2], m);
+}
+
+static void convert_row_nv12(BYTE *dst, const BYTE *y, const BYTE *uv, UINT32 width, const struct yuv_matrix *m)
+{
+    UINT32 x = 0;
+
+#if defined(__SSE2__)
+    __m128i zero = _mm_setzero_si128(), luma, cb, cr;
+
+    for (; x + 8 <= width; x += 8)
+    {
+        luma = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(y + x)), zero), _mm_set1_epi16(16));
+        split_chroma_sse2(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(uv + x)), zero), &cb, &cr);
+        yuv_to_bgra_sse2(dst + x * 4, luma, cb, cr, m);
+    }
+#endif
+
+    for (; x < width; x++)
+        yuv_to_bgra(dst + x * 4, y[x], uv[x & ~1], uv[x | 1], m);
+}
+
+static void convert_row_yuy2(BYTE *dst, const BYTE *src, UINT32 width, const struct yuv_matrix *m)
+{
+    UINT32 x = 0;
+
+#if defined(__SSE2__)
+    __m128i pixels, luma, cb, cr;
+
+    for (; x + 8 <= width; x += 8)
+    {
+        pixels = _mm_loadu_si128((const __m128i *)(src + x * 2));
+        luma = _mm_sub_epi16(_mm_and_si128(pixels, _mm_set1_epi16(0xff)), _mm_set1_epi16(16));
+        split_chroma_sse2(_mm_srli_epi16(pixels, 8), &cb, &cr);
+        yuv_to_bgra_sse2(dst + x * 4, luma, cb, cr, m);
+    }
+#endif
+
+    for (; x < width; x++)
+        yuv_to_bgra(dst + x * 4, src[x * 2], src[(x & ~1) * 2 + 1], src[(x & ~1) * 2 + 3], m);
+}
+
+static UINT32 get_input_size(const struct video_convert *convert)
+{
+    UINT32 width = convert->width, height = convert->height;
+
+    if (convert->input_format == WG_VIDEO_FORMAT_YUY2)
+        return width * height * 2;
+    return width * height * 3 / 2;
+}
+
+static void convert_frame(const struct video_convert *convert, BYTE *dst, const BYTE *src)
+{
+    const struct yuv_matrix *matrix = convert->height > 576 ? &bt709_matrix : &bt601_matrix;
+    UINT32 width = convert->width, height = convert->height, row;
+    const BYTE *planes[2] = {src + width * height, src + width * height * 5 / 4};
+    int dst_stride = width * 4;
+
+    if (convert->flip)
+    {
+        dst += (height - 1) * dst_stride;
+        dst_stride = -dst_stride;
+    }
+
+    for (row = 0; row < height; row++, dst += dst_stride)
+    {
+        switch (convert->input_format)
+        {
+        case WG_VIDEO_FORMAT_NV12:
+            convert_row_nv12(dst, src + row * width, planes[0] + (row / 2) * width, width, matrix);
+            break;
+        case WG_VIDEO_FORMAT_I420:
+            convert_row_planar(dst, src + row * width, planes[0] + (row / 2) * (width / 2),
+                    planes[1] + (row / 2) * (width / 2), width, matrix);
+            break;
+        case WG_VIDEO_FORMAT_YV12:
+            convert_row_planar(dst, src + row * width, planes[1] + (row / 2) * (width / 2),
+                    planes[0] + (row / 2) * (width / 2), width, matrix);
+            break;
+        case WG_VIDEO_FORMAT_YUY2:
+            convert_row_yuy2(dst, src + row * width * 2, width, matrix);
+            break;
+        default:
+            assert(0);
+            break;
+        }
+    }
+}
+
+bool video_convert_init(struct video_convert *convert, const struct wg_format *input_format,
+        const struct wg_format *output_format)
+{
+    const int width = input_format->u.video.width, height = abs(input_format->u.video.height);
+
+    convert->input_format = WG_VIDEO_FORMAT_UNKNOWN;
+
+    if (input_format->major_type != WG_MAJOR_TYPE_VIDEO || output_format->major_type != WG_MAJOR_TYPE_VIDEO)
+        return false;
+
+    switch (input_format->u.video.format)
+    {
+    case WG_VIDEO_FORMAT_NV12:
+    case WG_VIDEO_FORMAT_I420:
+    case WG_VIDEO_FORMAT_YV12:
+    case WG_VIDEO_FORMAT_YUY2:
+        break;
+    default:
+        return false;
+    }
+
+    if (output_format->u.video.format != WG_VIDEO_FORMAT_BGRx
+            && output_format->u.video.format != WG_VIDEO_FORMAT_BGRA)
+        return false;
+
+    /* keep the plane layout identical to what GStreamer expects, which pads strides to 4 bytes */
+    if (!width || !height || width % 8 || height % 2)
+        return false;
+    if (output_format->u.video.width != width || abs(output_format->u.video.height) != height)
+        return false;
+    /* GStreamer defaults to BT.2020 colorimetry from 2160 lines on, which we don't implement */
+    if (height >= 2160)
+        return false;
+
+    convert->input_format = input_format->u.video.format;
+    convert->width = width;
+    convert->height = height;
+    convert->flip = (input_format->u.video.height < 0) != (output_format->u.video.height < 0);
+
+    TRACE("Using native conversion from %u to %u, %ux%u, flip %u.\n", input_format->u.video.format,
+            output_format->u.video.format, width, height, convert->flip);
+    return true;
+}
+
+void video_convert_cleanup(struct video_convert *convert)
+{
+    if (convert->sample)
+        IMFSample_Release(convert->sample);
+    convert->sample = NULL;
+}
+
+HRESULT video_convert_push_mf(struct video_convert *convert, IMFSample *sample)
+{
+    TRACE("convert %p, sample %p.\n", convert, sample);
+
+    if (convert->sample)
+        return MF_E_NOTACCEPTING;
+
+    IMFSample_AddRef((convert->sample = sample));
+    return S_OK;
+}
+
+HRESULT video_convert_read_mf(struct video_convert *convert, IMFSample *sample)
+{
+    IMFMediaBuffer *input_buffer, *output_buffer;
+    DWORD input_size, output_size, max_length, length;
+    IMFSample *input = convert->sample;
+    LONGLONG time, duration;
+    BYTE *src, *dst;
+    UINT32 value;
+    HRESULT hr;
+
+    TRACE("convert %p, sample %p.\n", convert, sample);
+
+    if (!input)
+        return MF_E_TRANSFORM_NEED_MORE_INPUT;
+
+    input_size = get_input_size(convert);
+    output_size = convert->width * convert->height * 4;
+
+    if (FAILED(hr = IMFSample_ConvertToContiguousBuffer(sample, &output_buffer)))
+        return hr;
+    if (FAILED(hr = IMFSample_ConvertToContiguousBuffer(input, &input_buffer)))
+    {
+        IMFMediaBuffer_Release(output_buffer);
+        return hr;
+    }
+
+    if (SUCCEEDED(hr = IMFMediaBuffer_Lock(output_buffer, &dst, &max_length, NULL)))
+    {
+        if (max_length < output_size)
+            hr = MF_E_BUFFERTOOSMALL;
+        else if (SUCCEEDED(hr = IMFMediaBuffer_Lock(input_buffer, &src, NULL, &length)))
+        {
+            if (length < input_size)
+                hr = MF_E_INVALID_STREAM_DATA;
+            else
+                convert_frame(convert, dst, src);
+            IMFMediaBuffer_Unlock(input_buffer);
+        }
+        IMFMediaBuffer_Unlock(output_buffer);
+    }
+
+    if (SUCCEEDED(hr))
+        hr = IMFMediaBuffer_SetCurrentLength(output_buffer, output_size);
+    IMFMediaBuffer_Release(input_buffer);
+    IMFMediaBuffer_Release(output_buffer);
+
+    if (hr == MF_E_BUFFERTOOSMALL)
+        return hr;
+
+    if (SUCCEEDED(hr))
+    {
+        if (SUCCEEDED(IMFSample_GetSampleTime(input, &time)))
+            IMFSample_SetSampleTime(sample, time);
+        if (SUCCEEDED(IMFSample_GetSampleDuration(input, &duration)))
+            IMFSample_SetSampleDuration(sample, duration);
+        if (SUCCEEDED(IMFSample_GetUINT32(input, &MFSampleExtension_CleanPoint, &value)) && value)
+            IMFSample_SetUINT32(sample, &MFSampleExtension_CleanPoint, 1);
+        if (SUCCEEDED(IMFSample_GetUINT32(input, &MFSampleExtension_Discontinuity, &value)) && value)
+            IMFSample_SetUINT32(sample, &MFSampleExtension_Discontinuity, 1);
+    }
+
+    video_convert_cleanup(convert);
+    return hr;
+}
@@ -83,6 +83,8 @@ struct video_processor
 
     wg_transform_t wg_transform;
     struct wg_sample_queue *wg_sample_queue;
+    struct video_convert video_convert;
+    bool use_video_convert;
 };
 
 static HRESULT try_create_wg_transform(struct video_processor *impl)
@@ -93,6 +95,8 @@ static HRESULT try_create_wg_transform(struct video_processor *impl)
     if (impl->wg_transform)
         wg_transform_destroy(impl->wg_transform);
     impl->wg_transform = 0;
+    impl->use_video_convert = false;
+    video_convert_cleanup(&impl->video_convert);
 
     mf_media_type_to_wg_format(impl->input_type, &input_format);
     if (input_format.major_type == WG_MAJOR_TYPE_UNKNOWN)
@@ -105,6 +109,8 @@ static HRESULT try_create_wg_transform(struct video_processor *impl)
     if (!(impl->wg_transform = wg_transform_create(&input_format, &output_format, &attrs)))
         return E_FAIL;
 
+    /* convert the most common formats directly, avoiding the GStreamer round trip */
+    impl->use_video_convert = video_convert_init(&impl->video_convert, &input_format, &output_format);
     return S_OK;
 }
 
@@ -153,6 +159,7 @@ static ULONG WINAPI video_processor_Release(IMFTransform *iface)
     {
         if (impl->wg_transform)
             wg_transform_destroy(impl->wg_transform);
+        video_convert_cleanup(&impl->video_convert);
         if (impl->input_type)
             IMFMediaType_Release(impl->input_type);
         if (impl->output_type)
@@ -519,6 +526,8 @@ static HRESULT WINAPI video_processor_ProcessInput(IMFTransform *iface, DWORD id
     if (!impl->wg_transform)
         return MF_E_TRANSFORM_TYPE_NOT_SET;
 
+    if (impl->use_video_convert)
+        return video_convert_push_mf(&impl->video_convert, sample);
     return wg_transform_push_mf(impl->wg_transform, sample, impl->wg_sample_queue);
 }
 
@@ -541,6 +550,9 @@ static HRESULT WINAPI video_processor_ProcessOutput(IMFTransform *iface, DWORD f
     if (!samples->pSample)
         return E_INVALIDARG;
 
+    if (impl->use_video_convert)
+        return video_convert_read_mf(&impl->video_convert, samples->pSample);
+
     if (FAILED(hr = IMFTransform_GetOutputStreamInfo(iface, 0, &info)))
         return hr;
 
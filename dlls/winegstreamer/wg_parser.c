@@ -29,6 +29,7 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #define GLIB_VERSION_MIN_REQUIRED GLIB_VERSION_2_30
 #include <gst/gst.h>
@@ -971,6 +972,30 @@ static void free_stream(struct wg_parser_stream *stream)
     free(stream);
 }
 
+/* Decouple decoding from the client reading the stream, by letting the
+ * decoder run ahead by a configurable number of buffers. The queue goes in
+ * front of the converters, so that it only holds decoded buffers and the
+ * format chosen when the stream is enabled or reconfigured applies to every
+ * buffer reaching the sink afterwards. */
+static bool append_read_ahead_queue(struct wg_parser *parser, GstElement **first, GstElement **last)
+{
+    const char *env = getenv("WINE_GST_READ_AHEAD");
+    GstElement *element;
+    int depth;
+
+    if (!env || (depth = atoi(env)) <= 0)
+        return true;
+
+    if (!(element = create_element("queue", "core"))
+            || !append_element(parser->container, element, first, last))
+        return false;
+
+    g_object_set(element, "max-size-buffers", (guint)depth, "max-size-bytes", 0u,
+            "max-size-time", (guint64)0, NULL);
+    GST_INFO("Queueing up to %d buffers ahead of the client.", depth);
+    return true;
+}
+
 static bool stream_create_post_processing_elements(GstPad *pad, struct wg_parser_stream *stream)
 {
     GstElement *element = NULL, *first = NULL, *last = NULL;
@@ -984,6 +1009,8 @@ static bool stream_create_post_processing_elements(GstPad *pad, struct wg_parser
 
     if (!strcmp(name, "video/x-raw") && parser->use_opengl)
     {
+        if (!append_read_ahead_queue(parser, &first, &last))
+            return false;
         if (!(element = create_element("glupload", "base"))
                 || !append_element(parser->container, element, &first, &last))
             return false;
@@ -1009,6 +1036,9 @@ static bool stream_create_post_processing_elements(GstPad *pad, struct wg_parser
     }
     else if (!strcmp(name, "video/x-raw"))
     {
+        if (!append_read_ahead_queue(parser, &first, &last))
+            return false;
+
         /* Hack?: Flatten down the colorimetry to default values, without
          * actually modifying the video at all.
          *
@@ -1092,6 +1122,8 @@ static bool stream_create_post_processing_elements(GstPad *pad, struct wg_parser
          * surround-sound configurations. Native dsound can't always handle
          * 64-bit formats either. Add an audioconvert to allow changing bit
          * depth and channel count. */
+        if (!append_read_ahead_queue(parser, &first, &last))
+            return false;
         if (!(element = create_element("audioconvert", "base"))
                 || !append_element(parser->container, element, &first, &last))
             return false;
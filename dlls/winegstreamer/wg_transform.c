@@ -631,6 +631,28 @@ NTSTATUS wg_transform_push_data(void *args)
     return STATUS_SUCCESS;
 }
 
+static bool video_buffer_layout_matches(GstBuffer *buffer, const GstVideoInfo *src_info,
+        const GstVideoInfo *dst_info)
+{
+    GstVideoMeta *meta = gst_buffer_get_video_meta(buffer);
+    guint i;
+
+    if (meta && meta->n_planes != GST_VIDEO_INFO_N_PLANES(dst_info))
+        return false;
+
+    for (i = 0; i < GST_VIDEO_INFO_N_PLANES(dst_info); ++i)
+    {
+        gsize offset = meta ? meta->offset[i] : GST_VIDEO_INFO_PLANE_OFFSET(src_info, i);
+        gint stride = meta ? meta->stride[i] : GST_VIDEO_INFO_PLANE_STRIDE(src_info, i);
+
+        if (offset != GST_VIDEO_INFO_PLANE_OFFSET(dst_info, i)
+                || stride != GST_VIDEO_INFO_PLANE_STRIDE(dst_info, i))
+            return false;
+    }
+
+    return true;
+}
+
 static NTSTATUS copy_video_buffer(GstBuffer *buffer, GstCaps *caps, gsize plane_align,
         struct wg_sample *sample, gsize *total_size)
 {
@@ -655,6 +677,21 @@ static NTSTATUS copy_video_buffer(GstBuffer *buffer, GstCaps *caps, gsize plane_
         return STATUS_BUFFER_TOO_SMALL;
     }
 
+    /* When the decoder already used the output plane layout, but not our
+     * memory, a single linear copy is enough and avoids mapping both frames. */
+    if (video_buffer_layout_matches(buffer, &src_info, &dst_info))
+    {
+        gsize size = min(gst_buffer_get_size(buffer), dst_info.size);
+
+        if (gst_buffer_extract(buffer, 0, wg_sample_data(sample), size) != size)
+        {
+            GST_ERROR("Failed to extract video buffer.");
+            return STATUS_UNSUCCESSFUL;
+        }
+        *total_size = sample->size = dst_info.size;
+        return STATUS_SUCCESS;
+    }
+
     if (!(dst_buffer = gst_buffer_new_wrapped_full(0, wg_sample_data(sample), sample->max_size,
             0, sample->max_size, 0, NULL)))
     {
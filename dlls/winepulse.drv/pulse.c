@@ -1119,7 +1119,7 @@ static HRESULT get_device_period_helper(EDataFlow flow, const char *pulse_name,
 static NTSTATUS pulse_create_stream(void *args)
 {
     struct create_stream_params *params = args;
-    REFERENCE_TIME period, duration = params->duration;
+    REFERENCE_TIME period, min_period, duration = params->duration;
     struct pulse_stream *stream;
     unsigned int i, bufsize_bytes;
     HRESULT hr;
@@ -1160,10 +1160,14 @@ static NTSTATUS pulse_create_stream(void *args)
         goto exit;
 
     period = 0;
-    hr = get_device_period_helper(params->flow, params->device, &period, NULL);
+    hr = get_device_period_helper(params->flow, params->device, &period, &min_period);
     if (FAILED(hr))
         goto exit;
 
+    /* A shared mode period is only requested through IAudioClient3. */
+    if (params->period)
+        period = max(min(params->period, period), min_period);
+
     if (duration < 3 * period)
         duration = 3 * period;
 
@@ -3843,6 +3843,9 @@ static inline HRESULT HRESULT_FROM_WIN32(unsigned int x)
 #define D3D11_ERROR_TOO_MANY_UNIQUE_VIEW_OBJECTS           _HRESULT_TYPEDEF_(0x887c0003)
 #define D3D11_ERROR_DEFERRED_CONTEXT_MAP_WITHOUT_INITIAL_DISCARD  _HRESULT_TYPEDEF_(0x887c0004)
 
+#define D3D12_ERROR_ADAPTER_NOT_FOUND                      _HRESULT_TYPEDEF_(0x887e0001)
+#define D3D12_ERROR_DRIVER_VERSION_MISMATCH                _HRESULT_TYPEDEF_(0x887e0002)
+
 #define WINCODEC_ERR_WRONGSTATE                            _HRESULT_TYPEDEF_(0x88982f04)
 #define WINCODEC_ERR_VALUEOUTOFRANGE                       _HRESULT_TYPEDEF_(0x88982f05)
 #define WINCODEC_ERR_UNKNOWNIMAGEFORMAT                    _HRESULT_TYPEDEF_(0x88982f07)
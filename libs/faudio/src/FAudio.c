@@ -1255,15 +1255,15 @@ uint32_t FAudioVoice_SetOutputVoices(
 			}
 			else if (outChannels == 2)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_2out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_2out;
 			}
 			else if (outChannels == 6)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_6out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_6out;
 			}
 			else if (outChannels == 8)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_8out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_1in_8out;
 			}
 			else
 			{
@@ -1278,15 +1278,15 @@ uint32_t FAudioVoice_SetOutputVoices(
 			}
 			else if (outChannels == 2)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_2out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_2out;
 			}
 			else if (outChannels == 6)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_6out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_6out;
 			}
 			else if (outChannels == 8)
 			{
-				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_8out_Scalar;
+				voice->sendMix[i] = FAudio_INTERNAL_Mix_2in_8out;
 			}
 			else
 			{
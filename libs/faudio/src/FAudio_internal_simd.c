@@ -1543,6 +1543,305 @@ void FAudio_INTERNAL_Mix_2in_8out_Scalar(
 	}
 }
 
+#if HAVE_SSE2_INTRINSICS
+void FAudio_INTERNAL_Mix_1in_2out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const __m128 co = _mm_setr_ps(
+		coefficients[0], coefficients[1],
+		coefficients[0], coefficients[1]
+	);
+
+	/* Four frames per iteration, same operation order as the scalar path */
+	for (i = 0; toMix - i >= 4; i += 4, src += 4, dst += 8)
+	{
+		const __m128 dat = _mm_loadu_ps(src);
+		_mm_storeu_ps(dst, _mm_add_ps(
+			_mm_loadu_ps(dst),
+			_mm_mul_ps(_mm_unpacklo_ps(dat, dat), co)
+		));
+		_mm_storeu_ps(dst + 4, _mm_add_ps(
+			_mm_loadu_ps(dst + 4),
+			_mm_mul_ps(_mm_unpackhi_ps(dat, dat), co)
+		));
+	}
+
+	for (; i < toMix; i += 1, src += 1, dst += 2)
+	{
+		dst[0] += src[0] * coefficients[0];
+		dst[1] += src[0] * coefficients[1];
+	}
+}
+
+void FAudio_INTERNAL_Mix_1in_6out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const __m128 co0 = _mm_loadu_ps(coefficients);
+	const __m128 co1 = _mm_setr_ps(
+		coefficients[4], coefficients[5],
+		coefficients[0], coefficients[1]
+	);
+	const __m128 co2 = _mm_loadu_ps(coefficients + 2);
+
+	/* Two frames (12 samples) per iteration */
+	for (i = 0; toMix - i >= 2; i += 2, src += 2, dst += 12)
+	{
+		const __m128 a = _mm_set1_ps(src[0]);
+		const __m128 b = _mm_set1_ps(src[1]);
+		const __m128 ab = _mm_setr_ps(src[0], src[0], src[1], src[1]);
+		_mm_storeu_ps(dst, _mm_add_ps(
+			_mm_loadu_ps(dst),
+			_mm_mul_ps(a, co0)
+		));
+		_mm_storeu_ps(dst + 4, _mm_add_ps(
+			_mm_loadu_ps(dst + 4),
+			_mm_mul_ps(ab, co1)
+		));
+		_mm_storeu_ps(dst + 8, _mm_add_ps(
+			_mm_loadu_ps(dst + 8),
+			_mm_mul_ps(b, co2)
+		));
+	}
+
+	for (; i < toMix; i += 1, src += 1, dst += 6)
+	{
+		dst[0] += src[0] * coefficients[0];
+		dst[1] += src[0] * coefficients[1];
+		dst[2] += src[0] * coefficients[2];
+		dst[3] += src[0] * coefficients[3];
+		dst[4] += src[0] * coefficients[4];
+		dst[5] += src[0] * coefficients[5];
+	}
+}
+
+void FAudio_INTERNAL_Mix_1in_8out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const __m128 co0 = _mm_loadu_ps(coefficients);
+	const __m128 co1 = _mm_loadu_ps(coefficients + 4);
+
+	for (i = 0; i < toMix; i += 1, src += 1, dst += 8)
+	{
+		const __m128 dat = _mm_set1_ps(src[0]);
+		_mm_storeu_ps(dst, _mm_add_ps(
+			_mm_loadu_ps(dst),
+			_mm_mul_ps(dat, co0)
+		));
+		_mm_storeu_ps(dst + 4, _mm_add_ps(
+			_mm_loadu_ps(dst + 4),
+			_mm_mul_ps(dat, co1)
+		));
+	}
+}
+
+void FAudio_INTERNAL_Mix_2in_2out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const __m128 coL = _mm_setr_ps(
+		coefficients[0], coefficients[2],
+		coefficients[0], coefficients[2]
+	);
+	const __m128 coR = _mm_setr_ps(
+		coefficients[1], coefficients[3],
+		coefficients[1], coefficients[3]
+	);
+
+	/* Two frames per iteration, same operation order as the scalar path */
+	for (i = 0; toMix - i >= 2; i += 2, src += 4, dst += 4)
+	{
+		const __m128 dat = _mm_loadu_ps(src);
+		const __m128 left = _mm_shuffle_ps(dat, dat, _MM_SHUFFLE(2, 2, 0, 0));
+		const __m128 right = _mm_shuffle_ps(dat, dat, _MM_SHUFFLE(3, 3, 1, 1));
+		_mm_storeu_ps(dst, _mm_add_ps(
+			_mm_loadu_ps(dst),
+			_mm_add_ps(
+				_mm_mul_ps(left, coL),
+				_mm_mul_ps(right, coR)
+			)
+		));
+	}
+
+	for (; i < toMix; i += 1, src += 2, dst += 2)
+	{
+		dst[0] += (
+			(src[0] * coefficients[0]) +
+			(src[1] * coefficients[1])
+		);
+		dst[1] += (
+			(src[0] * coefficients[2]) +
+			(src[1] * coefficients[3])
+		);
+	}
+}
+
+void FAudio_INTERNAL_Mix_2in_6out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const __m128 coL0 = _mm_setr_ps(
+		coefficients[0], coefficients[2],
+		coefficients[4], coefficients[6]
+	);
+	const __m128 coR0 = _mm_setr_ps(
+		coefficients[1], coefficients[3],
+		coefficients[5], coefficients[7]
+	);
+	const __m128 coL1 = _mm_setr_ps(
+		coefficients[8], coefficients[10],
+		coefficients[0], coefficients[2]
+	);
+	const __m128 coR1 = _mm_setr_ps(
+		coefficients[9], coefficients[11],
+		coefficients[1], coefficients[3]
+	);
+	const __m128 coL2 = _mm_setr_ps(
+		coefficients[4], coefficients[6],
+		coefficients[8], coefficients[10]
+	);
+	const __m128 coR2 = _mm_setr_ps(
+		coefficients[5], coefficients[7],
+		coefficients[9], coefficients[11]
+	);
+
+	/* Two frames (12 samples) per iteration */
+	for (i = 0; toMix - i >= 2; i += 2, src += 4, dst += 12)
+	{
+		const __m128 dat = _mm_loadu_ps(src);
+		const __m128 left0 = _mm_shuffle_ps(dat, dat, _MM_SHUFFLE(0, 0, 0, 0));
+		const __m128 right0 = _mm_shuffle_ps(dat, dat, _MM_SHUFFLE(1, 1, 1, 1));
+		const __m128 left01 = _mm_shuffle_ps(dat, dat, _MM_SHUFFLE(2, 2, 0, 0));
+		const __m128 right01 = _mm_shuffle_ps(dat, dat, _MM_SHUFFLE(3, 3, 1, 1));
+		const __m128 left1 = _mm_shuffle_ps(dat, dat, _MM_SHUFFLE(2, 2, 2, 2));
+		const __m128 right1 = _mm_shuffle_ps(dat, dat, _MM_SHUFFLE(3, 3, 3, 3));
+		_mm_storeu_ps(dst, _mm_add_ps(
+			_mm_loadu_ps(dst),
+			_mm_add_ps(
+				_mm_mul_ps(left0, coL0),
+				_mm_mul_ps(right0, coR0)
+			)
+		));
+		_mm_storeu_ps(dst + 4, _mm_add_ps(
+			_mm_loadu_ps(dst + 4),
+			_mm_add_ps(
+				_mm_mul_ps(left01, coL1),
+				_mm_mul_ps(right01, coR1)
+			)
+		));
+		_mm_storeu_ps(dst + 8, _mm_add_ps(
+			_mm_loadu_ps(dst + 8),
+			_mm_add_ps(
+				_mm_mul_ps(left1, coL2),
+				_mm_mul_ps(right1, coR2)
+			)
+		));
+	}
+
+	for (; i < toMix; i += 1, src += 2, dst += 6)
+	{
+		dst[0] += (
+			(src[0] * coefficients[0]) +
+			(src[1] * coefficients[1])
+		);
+		dst[1] += (
+			(src[0] * coefficients[2]) +
+			(src[1] * coefficients[3])
+		);
+		dst[2] += (
+			(src[0] * coefficients[4]) +
+			(src[1] * coefficients[5])
+		);
+		dst[3] += (
+			(src[0] * coefficients[6]) +
+			(src[1] * coefficients[7])
+		);
+		dst[4] += (
+			(src[0] * coefficients[8]) +
+			(src[1] * coefficients[9])
+		);
+		dst[5] += (
+			(src[0] * coefficients[10]) +
+			(src[1] * coefficients[11])
+		);
+	}
+}
+
+void FAudio_INTERNAL_Mix_2in_8out_SSE2(
+	uint32_t toMix,
+	uint32_t UNUSED1,
+	uint32_t UNUSED2,
+	float *restrict src,
+	float *restrict dst,
+	float *restrict coefficients
+) {
+	uint32_t i;
+	const __m128 coL0 = _mm_setr_ps(
+		coefficients[0], coefficients[2],
+		coefficients[4], coefficients[6]
+	);
+	const __m128 coR0 = _mm_setr_ps(
+		coefficients[1], coefficients[3],
+		coefficients[5], coefficients[7]
+	);
+	const __m128 coL1 = _mm_setr_ps(
+		coefficients[8], coefficients[10],
+		coefficients[12], coefficients[14]
+	);
+	const __m128 coR1 = _mm_setr_ps(
+		coefficients[9], coefficients[11],
+		coefficients[13], coefficients[15]
+	);
+
+	for (i = 0; i < toMix; i += 1, src += 2, dst += 8)
+	{
+		const __m128 left = _mm_set1_ps(src[0]);
+		const __m128 right = _mm_set1_ps(src[1]);
+		_mm_storeu_ps(dst, _mm_add_ps(
+			_mm_loadu_ps(dst),
+			_mm_add_ps(
+				_mm_mul_ps(left, coL0),
+				_mm_mul_ps(right, coR0)
+			)
+		));
+		_mm_storeu_ps(dst + 4, _mm_add_ps(
+			_mm_loadu_ps(dst + 4),
+			_mm_add_ps(
+				_mm_mul_ps(left, coL1),
+				_mm_mul_ps(right, coR1)
+			)
+		));
+	}
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
 /* SECTION 5: InitSIMDFunctions. Assigns based on SSE2/NEON support. */
 
 void (*FAudio_INTERNAL_Convert_U8_To_F32)(
@@ -1571,6 +1870,12 @@ void (*FAudio_INTERNAL_Amplify)(
 );
 
 FAudioMixCallback FAudio_INTERNAL_Mix_Generic;
+FAudioMixCallback FAudio_INTERNAL_Mix_1in_2out;
+FAudioMixCallback FAudio_INTERNAL_Mix_1in_6out;
+FAudioMixCallback FAudio_INTERNAL_Mix_1in_8out;
+FAudioMixCallback FAudio_INTERNAL_Mix_2in_2out;
+FAudioMixCallback FAudio_INTERNAL_Mix_2in_6out;
+FAudioMixCallback FAudio_INTERNAL_Mix_2in_8out;
 
 void FAudio_INTERNAL_InitSIMDFunctions(uint8_t hasSSE2, uint8_t hasNEON)
 {
@@ -1584,6 +1889,12 @@ void FAudio_INTERNAL_InitSIMDFunctions(uint8_t hasSSE2, uint8_t hasNEON)
 		FAudio_INTERNAL_ResampleStereo = FAudio_INTERNAL_ResampleStereo_SSE2;
 		FAudio_INTERNAL_Amplify = FAudio_INTERNAL_Amplify_SSE2;
 		FAudio_INTERNAL_Mix_Generic = FAudio_INTERNAL_Mix_Generic_SSE2;
+		FAudio_INTERNAL_Mix_1in_2out = FAudio_INTERNAL_Mix_1in_2out_SSE2;
+		FAudio_INTERNAL_Mix_1in_6out = FAudio_INTERNAL_Mix_1in_6out_SSE2;
+		FAudio_INTERNAL_Mix_1in_8out = FAudio_INTERNAL_Mix_1in_8out_SSE2;
+		FAudio_INTERNAL_Mix_2in_2out = FAudio_INTERNAL_Mix_2in_2out_SSE2;
+		FAudio_INTERNAL_Mix_2in_6out = FAudio_INTERNAL_Mix_2in_6out_SSE2;
+		FAudio_INTERNAL_Mix_2in_8out = FAudio_INTERNAL_Mix_2in_8out_SSE2;
 		return;
 	}
 #endif
@@ -1597,6 +1908,12 @@ void FAudio_INTERNAL_InitSIMDFunctions(uint8_t hasSSE2, uint8_t hasNEON)
 		FAudio_INTERNAL_ResampleStereo = FAudio_INTERNAL_ResampleStereo_NEON;
 		FAudio_INTERNAL_Amplify = FAudio_INTERNAL_Amplify_NEON;
 		FAudio_INTERNAL_Mix_Generic = FAudio_INTERNAL_Mix_Generic_Scalar;
+		FAudio_INTERNAL_Mix_1in_2out = FAudio_INTERNAL_Mix_1in_2out_Scalar;
+		FAudio_INTERNAL_Mix_1in_6out = FAudio_INTERNAL_Mix_1in_6out_Scalar;
+		FAudio_INTERNAL_Mix_1in_8out = FAudio_INTERNAL_Mix_1in_8out_Scalar;
+		FAudio_INTERNAL_Mix_2in_2out = FAudio_INTERNAL_Mix_2in_2out_Scalar;
+		FAudio_INTERNAL_Mix_2in_6out = FAudio_INTERNAL_Mix_2in_6out_Scalar;
+		FAudio_INTERNAL_Mix_2in_8out = FAudio_INTERNAL_Mix_2in_8out_Scalar;
 		return;
 	}
 #endif
@@ -1608,6 +1925,12 @@ void FAudio_INTERNAL_InitSIMDFunctions(uint8_t hasSSE2, uint8_t hasNEON)
 	FAudio_INTERNAL_ResampleStereo = FAudio_INTERNAL_ResampleStereo_Scalar;
 	FAudio_INTERNAL_Amplify = FAudio_INTERNAL_Amplify_Scalar;
 	FAudio_INTERNAL_Mix_Generic = FAudio_INTERNAL_Mix_Generic_Scalar;
+	FAudio_INTERNAL_Mix_1in_2out = FAudio_INTERNAL_Mix_1in_2out_Scalar;
+	FAudio_INTERNAL_Mix_1in_6out = FAudio_INTERNAL_Mix_1in_6out_Scalar;
+	FAudio_INTERNAL_Mix_1in_8out = FAudio_INTERNAL_Mix_1in_8out_Scalar;
+	FAudio_INTERNAL_Mix_2in_2out = FAudio_INTERNAL_Mix_2in_2out_Scalar;
+	FAudio_INTERNAL_Mix_2in_6out = FAudio_INTERNAL_Mix_2in_6out_Scalar;
+	FAudio_INTERNAL_Mix_2in_8out = FAudio_INTERNAL_Mix_2in_8out_Scalar;
 #else
 	FAudio_assert(0 && "Need converter functions!");
 #endif
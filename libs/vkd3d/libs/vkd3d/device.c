@@ -19,6 +19,10 @@
 #include "vkd3d_private.h"
 #include "vkd3d_version.h"
 
+#ifndef _WIN32
+# include <unistd.h>
+#endif
+
 #define VKD3D_MAX_UAV_CLEAR_DESCRIPTORS_PER_TYPE 256u
 
 struct vkd3d_struct
@@ -2050,6 +2054,238 @@ static HRESULT vkd3d_create_vk_device(struct d3d12_device *device,
     return hr;
 }
 
+void d3d12_device_get_pipeline_cache_header(struct d3d12_device *device,
+        struct vkd3d_pipeline_cache_header *header, uint32_t magic, size_t data_size)
+{
+    const struct vkd3d_vk_device_procs *vk_procs = &device->vk_procs;
+    VkPhysicalDeviceProperties properties;
+
+    VK_CALL(vkGetPhysicalDeviceProperties(device->vk_physical_device, &properties));
+
+    memset(header, 0, sizeof(*header));
+    header->magic = magic;
+    header->version = VKD3D_PIPELINE_CACHE_VERSION;
+    header->vendor_id = properties.vendorID;
+    header->device_id = properties.deviceID;
+    header->driver_version = properties.driverVersion;
+    header->data_size = data_size;
+    memcpy(header->uuid, properties.pipelineCacheUUID, sizeof(header->uuid));
+}
+
+HRESULT d3d12_device_validate_pipeline_cache_header(struct d3d12_device *device,
+        const struct vkd3d_pipeline_cache_header *header, uint32_t magic, size_t size)
+{
+    struct vkd3d_pipeline_cache_header expected;
+
+    if (size < sizeof(*header) || header->magic != magic || header->version != VKD3D_PIPELINE_CACHE_VERSION
+            || header->data_size > size - sizeof(*header))
+    {
+        WARN("Invalid pipeline cache header.\n");
+        return E_INVALIDARG;
+    }
+
+    d3d12_device_get_pipeline_cache_header(device, &expected, magic, 0);
+    if (header->vendor_id != expected.vendor_id || header->device_id != expected.device_id)
+    {
+        WARN("Pipeline cache was created for device %04x:%04x.\n", header->vendor_id, header->device_id);
+        return D3D12_ERROR_ADAPTER_NOT_FOUND;
+    }
+    if (header->driver_version != expected.driver_version
+            || memcmp(header->uuid, expected.uuid, sizeof(header->uuid)))
+    {
+        WARN("Pipeline cache was created by a different driver version.\n");
+        return D3D12_ERROR_DRIVER_VERSION_MISMATCH;
+    }
+
+    return S_OK;
+}
+
+HRESULT d3d12_device_merge_pipeline_cache(struct d3d12_device *device, const void *data, size_t size)
+{
+    const struct vkd3d_vk_device_procs *vk_procs = &device->vk_procs;
+    VkPipelineCacheCreateInfo cache_info;
+    VkPipelineCache vk_cache;
+    VkResult vr;
+
+    if (!device->vk_pipeline_cache || !size)
+        return S_OK;
+
+    cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cache_info.pNext = NULL;
+    cache_info.flags = 0;
+    cache_info.initialDataSize = size;
+    cache_info.pInitialData = data;
+    if ((vr = VK_CALL(vkCreatePipelineCache(device->vk_device, &cache_info, NULL, &vk_cache))) < 0)
+    {
+        WARN("Failed to create Vulkan pipeline cache, vr %d.\n", vr);
+        return hresult_from_vk_result(vr);
+    }
+
+    vr = VK_CALL(vkMergePipelineCaches(device->vk_device, device->vk_pipeline_cache, 1, &vk_cache));
+    VK_CALL(vkDestroyPipelineCache(device->vk_device, vk_cache, NULL));
+    if (vr < 0)
+    {
+        WARN("Failed to merge Vulkan pipeline caches, vr %d.\n", vr);
+        return hresult_from_vk_result(vr);
+    }
+
+    return S_OK;
+}
+
+HRESULT d3d12_device_get_pipeline_cache_data(struct d3d12_device *device, void *data, size_t *size)
+{
+    const struct vkd3d_vk_device_procs *vk_procs = &device->vk_procs;
+    VkResult vr;
+
+    if (!device->vk_pipeline_cache)
+    {
+        *size = 0;
+        return S_OK;
+    }
+
+    /* If the cache grew since its size was queried, VK_INCOMPLETE is
+     * returned; the data written is still a valid, smaller cache. */
+    if ((vr = VK_CALL(vkGetPipelineCacheData(device->vk_device, device->vk_pipeline_cache, size, data))) < 0)
+        return hresult_from_vk_result(vr);
+
+    return S_OK;
+}
+
+static char *vkd3d_get_pipeline_cache_path(void)
+{
+    char program_name[PATH_MAX], *dir = NULL, *path;
+    const char *env, *name;
+    size_t len;
+
+    /* VKD3D_SHADER_CACHE_PATH=0 disables the on-disk cache. */
+    if ((env = getenv("VKD3D_SHADER_CACHE_PATH")))
+    {
+        if (!*env || !strcmp(env, "0") || !(dir = vkd3d_strdup(env)))
+            return NULL;
+    }
+#ifdef _WIN32
+    else if ((env = getenv("LOCALAPPDATA")))
+    {
+        len = strlen(env) + sizeof("\\vkd3d");
+        if (!(dir = vkd3d_malloc(len)))
+            return NULL;
+        snprintf(dir, len, "%s\\vkd3d", env);
+        if (!CreateDirectoryA(dir, NULL) && GetLastError() != ERROR_ALREADY_EXISTS)
+        {
+            WARN("Failed to create pipeline cache directory %s.\n", debugstr_a(dir));
+            vkd3d_free(dir);
+            return NULL;
+        }
+    }
+#endif
+
+    if (!dir)
+        return NULL;
+
+    name = vkd3d_get_program_name(program_name) && *program_name ? program_name : "vkd3d";
+    len = strlen(dir) + strlen(name) + sizeof("/.pipeline-cache");
+    if ((path = vkd3d_malloc(len)))
+        snprintf(path, len, "%s/%s.pipeline-cache", dir, name);
+    vkd3d_free(dir);
+
+    return path;
+}
+
+static void d3d12_device_load_pipeline_cache(struct d3d12_device *device)
+{
+    struct vkd3d_pipeline_cache_header *header;
+    void *data = NULL;
+    long size;
+    FILE *f;
+
+    if (!(f = fopen(device->pipeline_cache_path, "rb")))
+        return;
+
+    if (fseek(f, 0, SEEK_END) || (size = ftell(f)) <= (long)sizeof(*header) || fseek(f, 0, SEEK_SET)
+            || !(data = vkd3d_malloc(size)) || fread(data, 1, size, f) != (size_t)size)
+    {
+        WARN("Failed to read pipeline cache %s.\n", debugstr_a(device->pipeline_cache_path));
+        vkd3d_free(data);
+        fclose(f);
+        return;
+    }
+    fclose(f);
+
+    header = data;
+    if (SUCCEEDED(d3d12_device_validate_pipeline_cache_header(device, header, VKD3D_PIPELINE_CACHE_MAGIC, size))
+            && SUCCEEDED(d3d12_device_merge_pipeline_cache(device, header + 1, header->data_size)))
+    {
+        TRACE("Loaded %u bytes of pipeline cache data from %s.\n",
+                header->data_size, debugstr_a(device->pipeline_cache_path));
+        device->pipeline_cache_size = header->data_size;
+    }
+
+    vkd3d_free(data);
+}
+
+static void d3d12_device_store_pipeline_cache(struct d3d12_device *device)
+{
+    struct vkd3d_pipeline_cache_header *header;
+    unsigned long pid;
+    char *tmp_path;
+    size_t size, len;
+    bool ret;
+    FILE *f;
+
+    if (!device->pipeline_cache_path || FAILED(d3d12_device_get_pipeline_cache_data(device, NULL, &size)))
+        return;
+
+    /* Vulkan caches only ever grow, so an unchanged size means there is
+     * nothing new to write. */
+    if (!size || size == device->pipeline_cache_size)
+        return;
+
+    if (!(header = vkd3d_malloc(sizeof(*header) + size)))
+        return;
+    if (FAILED(d3d12_device_get_pipeline_cache_data(device, header + 1, &size)))
+    {
+        vkd3d_free(header);
+        return;
+    }
+    d3d12_device_get_pipeline_cache_header(device, header, VKD3D_PIPELINE_CACHE_MAGIC, size);
+
+    /* Write to a temporary file and rename it, so that other processes
+     * never read a partially written cache. The temporary file is unique
+     * to the process, since several of them may store the cache at once. */
+#ifdef _WIN32
+    pid = GetCurrentProcessId();
+#else
+    pid = getpid();
+#endif
+    len = strlen(device->pipeline_cache_path) + sizeof(".ffffffffffffffff");
+    if (!(tmp_path = vkd3d_malloc(len)))
+    {
+        vkd3d_free(header);
+        return;
+    }
+    snprintf(tmp_path, len, "%s.%lx", device->pipeline_cache_path, pid);
+
+    if ((f = fopen(tmp_path, "wb")))
+    {
+        ret = fwrite(header, 1, sizeof(*header) + size, f) == sizeof(*header) + size;
+        ret = !fclose(f) && ret;
+#ifdef _WIN32
+        ret = ret && MoveFileExA(tmp_path, device->pipeline_cache_path, MOVEFILE_REPLACE_EXISTING);
+#else
+        ret = ret && !rename(tmp_path, device->pipeline_cache_path);
+#endif
+        if (ret)
+            TRACE("Stored %zu bytes of pipeline cache data to %s.\n", size, debugstr_a(device->pipeline_cache_path));
+        else
+            remove(tmp_path);
+    }
+    if (!f || !ret)
+        WARN("Failed to write pipeline cache %s.\n", debugstr_a(device->pipeline_cache_path));
+
+    vkd3d_free(tmp_path);
+    vkd3d_free(header);
+}
+
 static HRESULT d3d12_device_init_pipeline_cache(struct d3d12_device *device)
 {
     const struct vkd3d_vk_device_procs *vk_procs = &device->vk_procs;
@@ -2058,6 +2294,9 @@ static HRESULT d3d12_device_init_pipeline_cache(struct d3d12_device *device)
 
     vkd3d_mutex_init(&device->mutex);
 
+    device->pipeline_cache_path = NULL;
+    device->pipeline_cache_size = 0;
+
     cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
     cache_info.pNext = NULL;
     cache_info.flags = 0;
@@ -2068,8 +2307,12 @@ static HRESULT d3d12_device_init_pipeline_cache(struct d3d12_device *device)
     {
         ERR("Failed to create Vulkan pipeline cache, vr %d.\n", vr);
         device->vk_pipeline_cache = VK_NULL_HANDLE;
+        return S_OK;
     }
 
+    if ((device->pipeline_cache_path = vkd3d_get_pipeline_cache_path()))
+        d3d12_device_load_pipeline_cache(device);
+
     return S_OK;
 }
 
@@ -2079,6 +2322,7 @@ static void d3d12_device_destroy_pipeline_cache(struct d3d12_device *device)
 
     if (device->vk_pipeline_cache)
         VK_CALL(vkDestroyPipelineCache(device->vk_device, device->vk_pipeline_cache, NULL));
+    vkd3d_free(device->pipeline_cache_path);
 
     vkd3d_mutex_destroy(&device->mutex);
 }
@@ -2512,10 +2756,12 @@ static ULONG STDMETHODCALLTYPE d3d12_device_Release(ID3D12Device5 *iface)
 
         vkd3d_cleanup_format_info(device);
         vkd3d_vk_descriptor_heap_layouts_cleanup(device);
+        vkd3d_shader_compile_pool_cleanup(&device->shader_compile_pool, device);
         vkd3d_uav_clear_state_cleanup(&device->uav_clear_state, device);
         vkd3d_destroy_null_resources(&device->null_resources, device);
         vkd3d_gpu_va_allocator_cleanup(&device->gpu_va_allocator);
         vkd3d_render_pass_cache_cleanup(&device->render_pass_cache, device);
+        d3d12_device_store_pipeline_cache(device);
         d3d12_device_destroy_pipeline_cache(device);
         d3d12_device_destroy_vkd3d_queues(device);
         vkd3d_desc_object_cache_cleanup(&device->view_desc_cache);
@@ -3945,9 +4191,19 @@ static LUID * STDMETHODCALLTYPE d3d12_device_GetAdapterLuid(ID3D12Device5 *iface
 static HRESULT STDMETHODCALLTYPE d3d12_device_CreatePipelineLibrary(ID3D12Device5 *iface,
         const void *blob, SIZE_T blob_size, REFIID iid, void **lib)
 {
-    FIXME("iface %p, blob %p, blob_size %lu, iid %s, lib %p stub!\n", iface, blob, blob_size, debugstr_guid(iid), lib);
+    struct d3d12_device *device = impl_from_ID3D12Device5(iface);
+    struct d3d12_pipeline_library *object;
+    HRESULT hr;
+
+    TRACE("iface %p, blob %p, blob_size %lu, iid %s, lib %p.\n", iface, blob, blob_size, debugstr_guid(iid), lib);
+
+    if (blob_size && !blob)
+        return E_INVALIDARG;
 
-    return DXGI_ERROR_UNSUPPORTED;
+    if (FAILED(hr = d3d12_pipeline_library_create(device, blob, blob_size, &object)))
+        return hr;
+
+    return return_interface(&object->ID3D12PipelineLibrary1_iface, &IID_ID3D12PipelineLibrary, iid, lib);
 }
 
 static HRESULT STDMETHODCALLTYPE d3d12_device_SetEventOnMultipleFenceCompletion(ID3D12Device5 *iface,
@@ -4291,6 +4547,9 @@ static HRESULT d3d12_device_init(struct d3d12_device *device,
     if (FAILED(hr = vkd3d_vk_descriptor_heap_layouts_init(device)))
         goto out_cleanup_uav_clear_state;
 
+    if (FAILED(hr = vkd3d_shader_compile_pool_init(&device->shader_compile_pool, device)))
+        goto out_cleanup_descriptor_heap_layouts;
+
     vkd3d_render_pass_cache_init(&device->render_pass_cache);
     vkd3d_gpu_va_allocator_init(&device->gpu_va_allocator);
     vkd3d_time_domains_init(device);
@@ -4308,6 +4567,8 @@ static HRESULT d3d12_device_init(struct d3d12_device *device,
 
     return S_OK;
 
+out_cleanup_descriptor_heap_layouts:
+    vkd3d_vk_descriptor_heap_layouts_cleanup(device);
 out_cleanup_uav_clear_state:
     vkd3d_uav_clear_state_cleanup(&device->uav_clear_state, device);
 out_destroy_null_resources:
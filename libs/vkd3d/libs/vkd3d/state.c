@@ -1919,6 +1919,144 @@ static HRESULT pipeline_state_desc_from_d3d12_stream_desc(struct d3d12_pipeline_
     return S_OK;
 }
 
+static uint64_t vkd3d_hash_data(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *ptr = data;
+    size_t i;
+
+    /* FNV-1a */
+    for (i = 0; i < size; ++i)
+        hash = (hash ^ ptr[i]) * 0x100000001b3ull;
+
+    return hash;
+}
+
+static uint64_t vkd3d_hash_uint(uint64_t hash, uint32_t value)
+{
+    return vkd3d_hash_data(hash, &value, sizeof(value));
+}
+
+static uint64_t vkd3d_hash_string(uint64_t hash, const char *str)
+{
+    return str ? vkd3d_hash_data(hash, str, strlen(str) + 1) : vkd3d_hash_uint(hash, 0);
+}
+
+static uint64_t vkd3d_hash_shader_bytecode(uint64_t hash, const D3D12_SHADER_BYTECODE *code)
+{
+    hash = vkd3d_hash_uint(hash, code->BytecodeLength);
+    if (code->pShaderBytecode)
+        hash = vkd3d_hash_data(hash, code->pShaderBytecode, code->BytecodeLength);
+    return hash;
+}
+
+/* Pipeline libraries check that a pipeline is loaded with the description
+ * it was stored with. The description references application memory, so
+ * only a digest of it is kept; the root signature is compared through its
+ * shader interface. */
+static uint64_t d3d12_pipeline_state_desc_get_hash(const struct d3d12_pipeline_state_desc *desc)
+{
+    const D3D12_DEPTH_STENCIL_DESC1 *ds = &desc->depth_stencil_state;
+    const D3D12_RASTERIZER_DESC *rs = &desc->rasterizer_state;
+    struct d3d12_root_signature *root_signature;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    unsigned int i;
+
+    if ((root_signature = unsafe_impl_from_ID3D12RootSignature(desc->root_signature)))
+    {
+        hash = vkd3d_hash_uint(hash, root_signature->flags);
+        hash = vkd3d_hash_data(hash, root_signature->descriptor_mapping,
+                root_signature->binding_count * sizeof(*root_signature->descriptor_mapping));
+        hash = vkd3d_hash_data(hash, root_signature->root_constants,
+                root_signature->root_constant_count * sizeof(*root_signature->root_constants));
+    }
+
+    hash = vkd3d_hash_shader_bytecode(hash, &desc->vs);
+    hash = vkd3d_hash_shader_bytecode(hash, &desc->ps);
+    hash = vkd3d_hash_shader_bytecode(hash, &desc->ds);
+    hash = vkd3d_hash_shader_bytecode(hash, &desc->hs);
+    hash = vkd3d_hash_shader_bytecode(hash, &desc->gs);
+    hash = vkd3d_hash_shader_bytecode(hash, &desc->cs);
+
+    hash = vkd3d_hash_uint(hash, desc->stream_output.NumEntries);
+    for (i = 0; desc->stream_output.pSODeclaration && i < desc->stream_output.NumEntries; ++i)
+    {
+        const D3D12_SO_DECLARATION_ENTRY *e = &desc->stream_output.pSODeclaration[i];
+
+        hash = vkd3d_hash_uint(hash, e->Stream);
+        hash = vkd3d_hash_string(hash, e->SemanticName);
+        hash = vkd3d_hash_uint(hash, e->SemanticIndex);
+        hash = vkd3d_hash_uint(hash, e->StartComponent | (e->ComponentCount << 8) | (e->OutputSlot << 16));
+    }
+    hash = vkd3d_hash_uint(hash, desc->stream_output.NumStrides);
+    if (desc->stream_output.pBufferStrides)
+        hash = vkd3d_hash_data(hash, desc->stream_output.pBufferStrides,
+                desc->stream_output.NumStrides * sizeof(*desc->stream_output.pBufferStrides));
+    hash = vkd3d_hash_uint(hash, desc->stream_output.RasterizedStream);
+
+    hash = vkd3d_hash_uint(hash, desc->blend_state.AlphaToCoverageEnable);
+    hash = vkd3d_hash_uint(hash, desc->blend_state.IndependentBlendEnable);
+    for (i = 0; i < ARRAY_SIZE(desc->blend_state.RenderTarget); ++i)
+    {
+        const D3D12_RENDER_TARGET_BLEND_DESC *rt = &desc->blend_state.RenderTarget[i];
+
+        /* The write mask is followed by padding. */
+        hash = vkd3d_hash_data(hash, rt, offsetof(D3D12_RENDER_TARGET_BLEND_DESC, RenderTargetWriteMask));
+        hash = vkd3d_hash_uint(hash, rt->RenderTargetWriteMask);
+    }
+    hash = vkd3d_hash_uint(hash, desc->sample_mask);
+
+    hash = vkd3d_hash_uint(hash, rs->FillMode);
+    hash = vkd3d_hash_uint(hash, rs->CullMode);
+    hash = vkd3d_hash_uint(hash, rs->FrontCounterClockwise);
+    hash = vkd3d_hash_uint(hash, rs->DepthBias);
+    hash = vkd3d_hash_data(hash, &rs->DepthBiasClamp, sizeof(rs->DepthBiasClamp));
+    hash = vkd3d_hash_data(hash, &rs->SlopeScaledDepthBias, sizeof(rs->SlopeScaledDepthBias));
+    hash = vkd3d_hash_uint(hash, rs->DepthClipEnable);
+    hash = vkd3d_hash_uint(hash, rs->MultisampleEnable);
+    hash = vkd3d_hash_uint(hash, rs->AntialiasedLineEnable);
+    hash = vkd3d_hash_uint(hash, rs->ForcedSampleCount);
+    hash = vkd3d_hash_uint(hash, rs->ConservativeRaster);
+
+    hash = vkd3d_hash_uint(hash, ds->DepthEnable);
+    hash = vkd3d_hash_uint(hash, ds->DepthWriteMask);
+    hash = vkd3d_hash_uint(hash, ds->DepthFunc);
+    hash = vkd3d_hash_uint(hash, ds->StencilEnable);
+    hash = vkd3d_hash_uint(hash, ds->StencilReadMask | (ds->StencilWriteMask << 8));
+    hash = vkd3d_hash_data(hash, &ds->FrontFace, sizeof(ds->FrontFace));
+    hash = vkd3d_hash_data(hash, &ds->BackFace, sizeof(ds->BackFace));
+    hash = vkd3d_hash_uint(hash, ds->DepthBoundsTestEnable);
+
+    hash = vkd3d_hash_uint(hash, desc->input_layout.NumElements);
+    for (i = 0; desc->input_layout.pInputElementDescs && i < desc->input_layout.NumElements; ++i)
+    {
+        const D3D12_INPUT_ELEMENT_DESC *e = &desc->input_layout.pInputElementDescs[i];
+
+        hash = vkd3d_hash_string(hash, e->SemanticName);
+        hash = vkd3d_hash_uint(hash, e->SemanticIndex);
+        hash = vkd3d_hash_uint(hash, e->Format);
+        hash = vkd3d_hash_uint(hash, e->InputSlot);
+        hash = vkd3d_hash_uint(hash, e->AlignedByteOffset);
+        hash = vkd3d_hash_uint(hash, e->InputSlotClass);
+        hash = vkd3d_hash_uint(hash, e->InstanceDataStepRate);
+    }
+
+    hash = vkd3d_hash_uint(hash, desc->strip_cut_value);
+    hash = vkd3d_hash_uint(hash, desc->primitive_topology_type);
+    hash = vkd3d_hash_data(hash, &desc->rtv_formats, sizeof(desc->rtv_formats));
+    hash = vkd3d_hash_uint(hash, desc->dsv_format);
+    hash = vkd3d_hash_data(hash, &desc->sample_desc, sizeof(desc->sample_desc));
+    hash = vkd3d_hash_uint(hash, desc->view_instancing_desc.ViewInstanceCount);
+    if (desc->view_instancing_desc.pViewInstanceLocations)
+        hash = vkd3d_hash_data(hash, desc->view_instancing_desc.pViewInstanceLocations,
+                desc->view_instancing_desc.ViewInstanceCount
+                * sizeof(*desc->view_instancing_desc.pViewInstanceLocations));
+    hash = vkd3d_hash_uint(hash, desc->view_instancing_desc.Flags);
+    hash = vkd3d_hash_uint(hash, desc->node_mask);
+    hash = vkd3d_hash_uint(hash, desc->flags);
+
+    return hash;
+}
+
 struct vkd3d_pipeline_key
 {
     D3D12_PRIMITIVE_TOPOLOGY topology;
@@ -2188,6 +2326,155 @@ static HRESULT create_shader_stage(struct d3d12_device *device,
     return S_OK;
 }
 
+static struct vkd3d_shader_compile_task *vkd3d_shader_compile_pool_pop(struct vkd3d_shader_compile_pool *pool)
+{
+    struct list *entry;
+
+    if (!(entry = list_head(&pool->tasks)))
+        return NULL;
+    list_remove(entry);
+    return LIST_ENTRY(entry, struct vkd3d_shader_compile_task, entry);
+}
+
+/* Called with the pool mutex held. */
+static void vkd3d_shader_compile_pool_execute(struct vkd3d_shader_compile_pool *pool,
+        struct vkd3d_shader_compile_task *task)
+{
+    unsigned int *pending = task->pending;
+
+    vkd3d_mutex_unlock(&pool->mutex);
+    task->execute(task);
+    vkd3d_mutex_lock(&pool->mutex);
+
+    /* The task may be freed by its waiter as soon as the counter drops. */
+    if (!--*pending)
+        vkd3d_cond_broadcast(&pool->done_cond);
+}
+
+static void *vkd3d_shader_compile_pool_main(void *arg)
+{
+    struct vkd3d_shader_compile_pool *pool = arg;
+    struct vkd3d_shader_compile_task *task;
+
+    vkd3d_set_thread_name("vkd3d_compile");
+
+    vkd3d_mutex_lock(&pool->mutex);
+    while (!pool->should_exit)
+    {
+        if ((task = vkd3d_shader_compile_pool_pop(pool)))
+            vkd3d_shader_compile_pool_execute(pool, task);
+        else
+            vkd3d_cond_wait(&pool->cond, &pool->mutex);
+    }
+    vkd3d_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+
+void vkd3d_shader_compile_pool_submit(struct vkd3d_shader_compile_pool *pool,
+        struct vkd3d_shader_compile_task *task, unsigned int *pending)
+{
+    vkd3d_mutex_lock(&pool->mutex);
+    task->pending = pending;
+    ++*pending;
+    list_add_tail(&pool->tasks, &task->entry);
+    vkd3d_cond_signal(&pool->cond);
+    vkd3d_mutex_unlock(&pool->mutex);
+}
+
+void vkd3d_shader_compile_pool_wait(struct vkd3d_shader_compile_pool *pool, unsigned int *pending)
+{
+    struct vkd3d_shader_compile_task *task;
+
+    vkd3d_mutex_lock(&pool->mutex);
+    while (*pending)
+    {
+        /* Help out instead of sleeping; this also covers pools without threads. */
+        if ((task = vkd3d_shader_compile_pool_pop(pool)))
+            vkd3d_shader_compile_pool_execute(pool, task);
+        else
+            vkd3d_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    vkd3d_mutex_unlock(&pool->mutex);
+}
+
+HRESULT vkd3d_shader_compile_pool_init(struct vkd3d_shader_compile_pool *pool, struct d3d12_device *device)
+{
+    unsigned int thread_count;
+    HRESULT hr;
+
+    TRACE("pool %p.\n", pool);
+
+    pool->thread_count = 0;
+    pool->should_exit = false;
+    list_init(&pool->tasks);
+    vkd3d_mutex_init(&pool->mutex);
+    vkd3d_cond_init(&pool->cond);
+    vkd3d_cond_init(&pool->done_cond);
+
+    /* The creating thread translates shaders as well. */
+    thread_count = min(vkd3d_get_cpu_count() - 1, VKD3D_MAX_SHADER_COMPILE_THREADS);
+    while (pool->thread_count < thread_count)
+    {
+        if (FAILED(hr = vkd3d_create_thread(device->vkd3d_instance, vkd3d_shader_compile_pool_main,
+                pool, &pool->threads[pool->thread_count])))
+        {
+            WARN("Failed to create shader compile thread, hr %#x.\n", hr);
+            break;
+        }
+        ++pool->thread_count;
+    }
+
+    TRACE("Using %u shader compile threads.\n", pool->thread_count);
+
+    return S_OK;
+}
+
+void vkd3d_shader_compile_pool_cleanup(struct vkd3d_shader_compile_pool *pool, struct d3d12_device *device)
+{
+    unsigned int i;
+
+    TRACE("pool %p.\n", pool);
+
+    vkd3d_mutex_lock(&pool->mutex);
+    pool->should_exit = true;
+    vkd3d_cond_broadcast(&pool->cond);
+    vkd3d_mutex_unlock(&pool->mutex);
+
+    for (i = 0; i < pool->thread_count; ++i)
+        vkd3d_join_thread(device->vkd3d_instance, &pool->threads[i]);
+
+    vkd3d_cond_destroy(&pool->done_cond);
+    vkd3d_cond_destroy(&pool->cond);
+    vkd3d_mutex_destroy(&pool->mutex);
+}
+
+struct d3d12_shader_stage_task
+{
+    struct vkd3d_shader_compile_task task;
+
+    struct d3d12_device *device;
+    VkPipelineShaderStageCreateInfo *stage_desc;
+    VkShaderStageFlagBits stage;
+    const D3D12_SHADER_BYTECODE *code;
+
+    /* Each task owns its interface chain, since the chain is rebuilt per stage. */
+    struct vkd3d_shader_interface_info shader_interface;
+    struct vkd3d_shader_descriptor_offset_info offset_info;
+    struct vkd3d_shader_spirv_target_info target_info;
+    struct vkd3d_shader_transform_feedback_info xfb_info;
+
+    HRESULT hr;
+};
+
+static void d3d12_shader_stage_task_execute(struct vkd3d_shader_compile_task *task)
+{
+    struct d3d12_shader_stage_task *stage_task = CONTAINING_RECORD(task, struct d3d12_shader_stage_task, task);
+
+    stage_task->hr = create_shader_stage(stage_task->device, stage_task->stage_desc,
+            stage_task->stage, stage_task->code, &stage_task->shader_interface);
+}
+
 static int vkd3d_scan_dxbc(const struct d3d12_device *device, const D3D12_SHADER_BYTECODE *code,
         struct vkd3d_shader_scan_descriptor_info *descriptor_info)
 {
@@ -2236,7 +2523,7 @@ static HRESULT vkd3d_create_compute_pipeline(struct d3d12_device *device,
     pipeline_info.basePipelineIndex = -1;
 
     vr = VK_CALL(vkCreateComputePipelines(device->vk_device,
-            VK_NULL_HANDLE, 1, &pipeline_info, NULL, vk_pipeline));
+            device->vk_pipeline_cache, 1, &pipeline_info, NULL, vk_pipeline));
     VK_CALL(vkDestroyShaderModule(device->vk_device, pipeline_info.stage.module, NULL));
     if (vr < 0)
     {
@@ -2477,6 +2764,7 @@ HRESULT d3d12_pipeline_state_create_compute(struct d3d12_device *device,
         vkd3d_free(object);
         return hr;
     }
+    object->desc_hash = d3d12_pipeline_state_desc_get_hash(&pipeline_desc);
 
     TRACE("Created compute pipeline state %p.\n", object);
 
@@ -2933,8 +3221,11 @@ static HRESULT d3d12_pipeline_state_init_graphics(struct d3d12_pipeline_state *s
     VkVertexInputBindingDivisorDescriptionEXT *binding_divisor;
     const struct vkd3d_vulkan_info *vk_info = &device->vk_info;
     uint32_t instance_divisors[D3D12_VS_INPUT_REGISTER_COUNT];
+    struct d3d12_shader_stage_task stage_tasks[VKD3D_MAX_SHADER_STAGES];
     struct vkd3d_shader_spirv_target_info *stage_target_info;
     uint32_t aligned_offsets[D3D12_VS_INPUT_REGISTER_COUNT];
+    struct d3d12_shader_stage_task *stage_task;
+    unsigned int pending_stages = 0, task_count = 0;
     struct vkd3d_shader_descriptor_offset_info offset_info;
     struct vkd3d_shader_parameter ps_shader_parameters[1];
     struct vkd3d_shader_transform_feedback_info xfb_info;
@@ -3263,24 +3554,43 @@ static HRESULT d3d12_pipeline_state_init_graphics(struct d3d12_pipeline_state *s
                 goto fail;
         }
 
-        shader_interface.next = NULL;
-        xfb_info.next = NULL;
-        ps_target_info.next = NULL;
-        target_info.next = NULL;
-        offset_info.next = NULL;
+        stage_task = &stage_tasks[task_count++];
+        stage_task->task.execute = d3d12_shader_stage_task_execute;
+        stage_task->device = device;
+        stage_task->stage_desc = &graphics->stages[graphics->stage_count];
+        stage_task->stage_desc->module = VK_NULL_HANDLE;
+        stage_task->stage = shader_stages[i].stage;
+        stage_task->code = b;
+        stage_task->shader_interface = shader_interface;
+        stage_task->shader_interface.next = NULL;
         if (shader_stages[i].stage == xfb_stage)
-            vkd3d_prepend_struct(&shader_interface, &xfb_info);
-        vkd3d_prepend_struct(&shader_interface, stage_target_info);
+        {
+            stage_task->xfb_info = xfb_info;
+            stage_task->xfb_info.next = NULL;
+            vkd3d_prepend_struct(&stage_task->shader_interface, &stage_task->xfb_info);
+        }
+        stage_task->target_info = *stage_target_info;
+        stage_task->target_info.next = NULL;
+        vkd3d_prepend_struct(&stage_task->shader_interface, &stage_task->target_info);
         if (root_signature->descriptor_offsets)
-            vkd3d_prepend_struct(&shader_interface, &offset_info);
-
-        if (FAILED(hr = create_shader_stage(device, &graphics->stages[graphics->stage_count],
-                shader_stages[i].stage, b, &shader_interface)))
-            goto fail;
+        {
+            stage_task->offset_info = offset_info;
+            stage_task->offset_info.next = NULL;
+            vkd3d_prepend_struct(&stage_task->shader_interface, &stage_task->offset_info);
+        }
+        stage_task->hr = S_OK;
 
+        vkd3d_shader_compile_pool_submit(&device->shader_compile_pool, &stage_task->task, &pending_stages);
         ++graphics->stage_count;
     }
 
+    vkd3d_shader_compile_pool_wait(&device->shader_compile_pool, &pending_stages);
+    for (i = 0; i < task_count; ++i)
+    {
+        if (FAILED(hr = stage_tasks[i].hr))
+            goto fail;
+    }
+
     graphics->attribute_count = desc->input_layout.NumElements;
     if (graphics->attribute_count > ARRAY_SIZE(graphics->attributes))
     {
@@ -3457,6 +3767,7 @@ static HRESULT d3d12_pipeline_state_init_graphics(struct d3d12_pipeline_state *s
     return S_OK;
 
 fail:
+    vkd3d_shader_compile_pool_wait(&device->shader_compile_pool, &pending_stages);
     for (i = 0; i < graphics->stage_count; ++i)
     {
         VK_CALL(vkDestroyShaderModule(device->vk_device, state->u.graphics.stages[i].module, NULL));
@@ -3485,6 +3796,7 @@ HRESULT d3d12_pipeline_state_create_graphics(struct d3d12_device *device,
         vkd3d_free(object);
         return hr;
     }
+    object->desc_hash = d3d12_pipeline_state_desc_get_hash(&pipeline_desc);
 
     TRACE("Created graphics pipeline state %p.\n", object);
 
@@ -3526,6 +3838,7 @@ HRESULT d3d12_pipeline_state_create(struct d3d12_device *device,
         vkd3d_free(object);
         return hr;
     }
+    object->desc_hash = d3d12_pipeline_state_desc_get_hash(&pipeline_desc);
 
     TRACE("Created pipeline state %p.\n", object);
 
@@ -3533,6 +3846,514 @@ HRESULT d3d12_pipeline_state_create(struct d3d12_device *device,
     return S_OK;
 }
 
+static inline struct d3d12_pipeline_library *impl_from_ID3D12PipelineLibrary1(ID3D12PipelineLibrary1 *iface)
+{
+    return CONTAINING_RECORD(iface, struct d3d12_pipeline_library, ID3D12PipelineLibrary1_iface);
+}
+
+static HRESULT STDMETHODCALLTYPE d3d12_pipeline_library_QueryInterface(ID3D12PipelineLibrary1 *iface,
+        REFIID riid, void **object)
+{
+    TRACE("iface %p, riid %s, object %p.\n", iface, debugstr_guid(riid), object);
+
+    if (IsEqualGUID(riid, &IID_ID3D12PipelineLibrary1)
+            || IsEqualGUID(riid, &IID_ID3D12PipelineLibrary)
+            || IsEqualGUID(riid, &IID_ID3D12DeviceChild)
+            || IsEqualGUID(riid, &IID_ID3D12Object)
+            || IsEqualGUID(riid, &IID_IUnknown))
+    {
+        ID3D12PipelineLibrary1_AddRef(iface);
+        *object = iface;
+        return S_OK;
+    }
+
+    WARN("%s not implemented, returning E_NOINTERFACE.\n", debugstr_guid(riid));
+
+    *object = NULL;
+    return E_NOINTERFACE;
+}
+
+static ULONG STDMETHODCALLTYPE d3d12_pipeline_library_AddRef(ID3D12PipelineLibrary1 *iface)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+    ULONG refcount = InterlockedIncrement(&library->refcount);
+
+    TRACE("%p increasing refcount to %u.\n", library, refcount);
+
+    return refcount;
+}
+
+static void d3d12_pipeline_library_cleanup(struct d3d12_pipeline_library *library)
+{
+    size_t i;
+
+    for (i = 0; i < library->entry_count; ++i)
+        vkd3d_free(library->entries[i].name);
+    vkd3d_free(library->entries);
+    vkd3d_mutex_destroy(&library->mutex);
+}
+
+static ULONG STDMETHODCALLTYPE d3d12_pipeline_library_Release(ID3D12PipelineLibrary1 *iface)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+    ULONG refcount = InterlockedDecrement(&library->refcount);
+
+    TRACE("%p decreasing refcount to %u.\n", library, refcount);
+
+    if (!refcount)
+    {
+        struct d3d12_device *device = library->device;
+
+        vkd3d_private_store_destroy(&library->private_store);
+        d3d12_pipeline_library_cleanup(library);
+        vkd3d_free(library);
+
+        d3d12_device_release(device);
+    }
+
+    return refcount;
+}
+
+static HRESULT STDMETHODCALLTYPE d3d12_pipeline_library_GetPrivateData(ID3D12PipelineLibrary1 *iface,
+        REFGUID guid, UINT *data_size, void *data)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+
+    TRACE("iface %p, guid %s, data_size %p, data %p.\n", iface, debugstr_guid(guid), data_size, data);
+
+    return vkd3d_get_private_data(&library->private_store, guid, data_size, data);
+}
+
+static HRESULT STDMETHODCALLTYPE d3d12_pipeline_library_SetPrivateData(ID3D12PipelineLibrary1 *iface,
+        REFGUID guid, UINT data_size, const void *data)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+
+    TRACE("iface %p, guid %s, data_size %u, data %p.\n", iface, debugstr_guid(guid), data_size, data);
+
+    return vkd3d_set_private_data(&library->private_store, guid, data_size, data);
+}
+
+static HRESULT STDMETHODCALLTYPE d3d12_pipeline_library_SetPrivateDataInterface(ID3D12PipelineLibrary1 *iface,
+        REFGUID guid, const IUnknown *data)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+
+    TRACE("iface %p, guid %s, data %p.\n", iface, debugstr_guid(guid), data);
+
+    return vkd3d_set_private_data_interface(&library->private_store, guid, data);
+}
+
+static HRESULT STDMETHODCALLTYPE d3d12_pipeline_library_SetName(ID3D12PipelineLibrary1 *iface, const WCHAR *name)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+
+    TRACE("iface %p, name %s.\n", iface, debugstr_w(name, library->device->wchar_size));
+
+    return name ? S_OK : E_INVALIDARG;
+}
+
+static HRESULT STDMETHODCALLTYPE d3d12_pipeline_library_GetDevice(ID3D12PipelineLibrary1 *iface,
+        REFIID iid, void **device)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+
+    TRACE("iface %p, iid %s, device %p.\n", iface, debugstr_guid(iid), device);
+
+    return d3d12_device_query_interface(library->device, iid, device);
+}
+
+/* The caller must hold the library mutex. */
+static struct d3d12_pipeline_library_entry *d3d12_pipeline_library_find_entry(
+        struct d3d12_pipeline_library *library, const char *name)
+{
+    size_t i;
+
+    for (i = 0; i < library->entry_count; ++i)
+    {
+        if (!strcmp(library->entries[i].name, name))
+            return &library->entries[i];
+    }
+
+    return NULL;
+}
+
+/* The caller must hold the library mutex. */
+static HRESULT d3d12_pipeline_library_add_entry(struct d3d12_pipeline_library *library,
+        char *name, VkPipelineBindPoint vk_bind_point, uint64_t desc_hash)
+{
+    struct d3d12_pipeline_library_entry *entry;
+
+    if (d3d12_pipeline_library_find_entry(library, name))
+    {
+        WARN("Pipeline %s already exists.\n", debugstr_a(name));
+        return E_INVALIDARG;
+    }
+
+    if (!vkd3d_array_reserve((void **)&library->entries, &library->entries_size,
+            library->entry_count + 1, sizeof(*library->entries)))
+        return E_OUTOFMEMORY;
+
+    entry = &library->entries[library->entry_count++];
+    entry->name = name;
+    entry->vk_bind_point = vk_bind_point;
+    entry->desc_hash = desc_hash;
+
+    return S_OK;
+}
+
+static HRESULT STDMETHODCALLTYPE d3d12_pipeline_library_StorePipeline(ID3D12PipelineLibrary1 *iface,
+        const WCHAR *name, ID3D12PipelineState *pipeline)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+    struct d3d12_pipeline_state *state = unsafe_impl_from_ID3D12PipelineState(pipeline);
+    char *name_utf8;
+    HRESULT hr;
+
+    TRACE("iface %p, name %s, pipeline %p.\n", iface, debugstr_w(name, library->device->wchar_size), pipeline);
+
+    if (!name || !state)
+        return E_INVALIDARG;
+
+    if (!(name_utf8 = vkd3d_strdup_w_utf8(name, library->device->wchar_size)))
+        return E_OUTOFMEMORY;
+
+    /* The Vulkan pipelines themselves live in the device pipeline cache,
+     * which is serialised along with the library. */
+    vkd3d_mutex_lock(&library->mutex);
+    hr = d3d12_pipeline_library_add_entry(library, name_utf8, state->vk_bind_point, state->desc_hash);
+    vkd3d_mutex_unlock(&library->mutex);
+
+    if (FAILED(hr))
+        vkd3d_free(name_utf8);
+
+    return hr;
+}
+
+static HRESULT d3d12_pipeline_library_find_pipeline(struct d3d12_pipeline_library *library,
+        const WCHAR *name, VkPipelineBindPoint *vk_bind_point, uint64_t *desc_hash)
+{
+    struct d3d12_pipeline_library_entry *entry;
+    char *name_utf8;
+
+    if (!name)
+        return E_INVALIDARG;
+
+    if (!(name_utf8 = vkd3d_strdup_w_utf8(name, library->device->wchar_size)))
+        return E_OUTOFMEMORY;
+
+    vkd3d_mutex_lock(&library->mutex);
+    if ((entry = d3d12_pipeline_library_find_entry(library, name_utf8)))
+    {
+        *vk_bind_point = entry->vk_bind_point;
+        *desc_hash = entry->desc_hash;
+    }
+    vkd3d_mutex_unlock(&library->mutex);
+
+    if (!entry)
+        WARN("Pipeline %s not found.\n", debugstr_a(name_utf8));
+    vkd3d_free(name_utf8);
+
+    return entry ? S_OK : E_INVALIDARG;
+}
+
+static HRESULT STDMETHODCALLTYPE d3d12_pipeline_library_LoadGraphicsPipeline(ID3D12PipelineLibrary1 *iface,
+        const WCHAR *name, const D3D12_GRAPHICS_PIPELINE_STATE_DESC *desc, REFIID iid, void **pipeline_state)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+    struct d3d12_pipeline_state_desc pipeline_desc;
+    struct d3d12_pipeline_state *object;
+    VkPipelineBindPoint vk_bind_point;
+    uint64_t desc_hash;
+    HRESULT hr;
+
+    TRACE("iface %p, name %s, desc %p, iid %s, pipeline_state %p.\n", iface,
+            debugstr_w(name, library->device->wchar_size), desc, debugstr_guid(iid), pipeline_state);
+
+    if (FAILED(hr = d3d12_pipeline_library_find_pipeline(library, name, &vk_bind_point, &desc_hash)))
+        return hr;
+    if (vk_bind_point != VK_PIPELINE_BIND_POINT_GRAPHICS)
+        return E_INVALIDARG;
+
+    pipeline_state_desc_from_d3d12_graphics_desc(&pipeline_desc, desc);
+    if (d3d12_pipeline_state_desc_get_hash(&pipeline_desc) != desc_hash)
+    {
+        WARN("Pipeline description doesn't match the stored pipeline.\n");
+        return E_INVALIDARG;
+    }
+
+    if (FAILED(hr = d3d12_pipeline_state_create_graphics(library->device, desc, &object)))
+        return hr;
+
+    return return_interface(&object->ID3D12PipelineState_iface, &IID_ID3D12PipelineState, iid, pipeline_state);
+}
+
+static HRESULT STDMETHODCALLTYPE d3d12_pipeline_library_LoadComputePipeline(ID3D12PipelineLibrary1 *iface,
+        const WCHAR *name, const D3D12_COMPUTE_PIPELINE_STATE_DESC *desc, REFIID iid, void **pipeline_state)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+    struct d3d12_pipeline_state_desc pipeline_desc;
+    struct d3d12_pipeline_state *object;
+    VkPipelineBindPoint vk_bind_point;
+    uint64_t desc_hash;
+    HRESULT hr;
+
+    TRACE("iface %p, name %s, desc %p, iid %s, pipeline_state %p.\n", iface,
+            debugstr_w(name, library->device->wchar_size), desc, debugstr_guid(iid), pipeline_state);
+
+    if (FAILED(hr = d3d12_pipeline_library_find_pipeline(library, name, &vk_bind_point, &desc_hash)))
+        return hr;
+    if (vk_bind_point != VK_PIPELINE_BIND_POINT_COMPUTE)
+        return E_INVALIDARG;
+
+    pipeline_state_desc_from_d3d12_compute_desc(&pipeline_desc, desc);
+    if (d3d12_pipeline_state_desc_get_hash(&pipeline_desc) != desc_hash)
+    {
+        WARN("Pipeline description doesn't match the stored pipeline.\n");
+        return E_INVALIDARG;
+    }
+
+    if (FAILED(hr = d3d12_pipeline_state_create_compute(library->device, desc, &object)))
+        return hr;
+
+    return return_interface(&object->ID3D12PipelineState_iface, &IID_ID3D12PipelineState, iid, pipeline_state);
+}
+
+/* The caller must hold the library mutex. */
+static size_t d3d12_pipeline_library_get_serialized_size(struct d3d12_pipeline_library *library,
+        size_t cache_size)
+{
+    size_t i, size;
+
+    size = sizeof(struct vkd3d_pipeline_cache_header) + align(cache_size, sizeof(uint32_t)) + sizeof(uint32_t);
+    for (i = 0; i < library->entry_count; ++i)
+        size += 2 * sizeof(uint32_t) + sizeof(uint64_t) + align(strlen(library->entries[i].name) + 1, sizeof(uint32_t));
+
+    return size;
+}
+
+static SIZE_T STDMETHODCALLTYPE d3d12_pipeline_library_GetSerializedSize(ID3D12PipelineLibrary1 *iface)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+    size_t cache_size, size;
+
+    TRACE("iface %p.\n", iface);
+
+    if (FAILED(d3d12_device_get_pipeline_cache_data(library->device, NULL, &cache_size)))
+        cache_size = 0;
+
+    vkd3d_mutex_lock(&library->mutex);
+    size = d3d12_pipeline_library_get_serialized_size(library, cache_size);
+    vkd3d_mutex_unlock(&library->mutex);
+
+    return size;
+}
+
+static HRESULT STDMETHODCALLTYPE d3d12_pipeline_library_Serialize(ID3D12PipelineLibrary1 *iface,
+        void *data, SIZE_T data_size)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+    struct vkd3d_pipeline_cache_header *header = data;
+    size_t cache_size, name_size, i;
+    uint32_t value;
+    uint8_t *ptr;
+    HRESULT hr;
+
+    TRACE("iface %p, data %p, data_size %lu.\n", iface, data, data_size);
+
+    if (FAILED(hr = d3d12_device_get_pipeline_cache_data(library->device, NULL, &cache_size)))
+        return hr;
+
+    vkd3d_mutex_lock(&library->mutex);
+
+    if (data_size < d3d12_pipeline_library_get_serialized_size(library, cache_size))
+    {
+        WARN("Invalid data size %lu.\n", data_size);
+        vkd3d_mutex_unlock(&library->mutex);
+        return E_INVALIDARG;
+    }
+
+    /* The cache may only have grown since its size was queried, in which
+     * case a valid subset is returned. */
+    ptr = (uint8_t *)(header + 1);
+    if (FAILED(hr = d3d12_device_get_pipeline_cache_data(library->device, ptr, &cache_size)))
+    {
+        vkd3d_mutex_unlock(&library->mutex);
+        return hr;
+    }
+    d3d12_device_get_pipeline_cache_header(library->device, header, VKD3D_PIPELINE_LIBRARY_MAGIC, cache_size);
+    memset(ptr + cache_size, 0, align(cache_size, sizeof(uint32_t)) - cache_size);
+    ptr += align(cache_size, sizeof(uint32_t));
+
+    value = library->entry_count;
+    memcpy(ptr, &value, sizeof(value));
+    ptr += sizeof(value);
+    for (i = 0; i < library->entry_count; ++i)
+    {
+        const struct d3d12_pipeline_library_entry *entry = &library->entries[i];
+
+        name_size = strlen(entry->name) + 1;
+        value = entry->vk_bind_point;
+        memcpy(ptr, &value, sizeof(value));
+        ptr += sizeof(value);
+        memcpy(ptr, &entry->desc_hash, sizeof(entry->desc_hash));
+        ptr += sizeof(entry->desc_hash);
+        value = name_size;
+        memcpy(ptr, &value, sizeof(value));
+        ptr += sizeof(value);
+        memset(ptr, 0, align(name_size, sizeof(uint32_t)));
+        memcpy(ptr, entry->name, name_size);
+        ptr += align(name_size, sizeof(uint32_t));
+    }
+
+    vkd3d_mutex_unlock(&library->mutex);
+
+    return S_OK;
+}
+
+static HRESULT STDMETHODCALLTYPE d3d12_pipeline_library_LoadPipeline(ID3D12PipelineLibrary1 *iface,
+        const WCHAR *name, const D3D12_PIPELINE_STATE_STREAM_DESC *desc, REFIID iid, void **pipeline_state)
+{
+    struct d3d12_pipeline_library *library = impl_from_ID3D12PipelineLibrary1(iface);
+    struct d3d12_pipeline_state *object;
+    VkPipelineBindPoint vk_bind_point;
+    uint64_t desc_hash;
+    HRESULT hr;
+
+    TRACE("iface %p, name %s, desc %p, iid %s, pipeline_state %p.\n", iface,
+            debugstr_w(name, library->device->wchar_size), desc, debugstr_guid(iid), pipeline_state);
+
+    if (FAILED(hr = d3d12_pipeline_library_find_pipeline(library, name, &vk_bind_point, &desc_hash)))
+        return hr;
+
+    if (FAILED(hr = d3d12_pipeline_state_create(library->device, desc, &object)))
+        return hr;
+
+    if (object->vk_bind_point != vk_bind_point || object->desc_hash != desc_hash)
+    {
+        WARN("Pipeline description doesn't match the stored pipeline.\n");
+        ID3D12PipelineState_Release(&object->ID3D12PipelineState_iface);
+        return E_INVALIDARG;
+    }
+
+    return return_interface(&object->ID3D12PipelineState_iface, &IID_ID3D12PipelineState, iid, pipeline_state);
+}
+
+static const struct ID3D12PipelineLibrary1Vtbl d3d12_pipeline_library_vtbl =
+{
+    /* IUnknown methods */
+    d3d12_pipeline_library_QueryInterface,
+    d3d12_pipeline_library_AddRef,
+    d3d12_pipeline_library_Release,
+    /* ID3D12Object methods */
+    d3d12_pipeline_library_GetPrivateData,
+    d3d12_pipeline_library_SetPrivateData,
+    d3d12_pipeline_library_SetPrivateDataInterface,
+    d3d12_pipeline_library_SetName,
+    /* ID3D12DeviceChild methods */
+    d3d12_pipeline_library_GetDevice,
+    /* ID3D12PipelineLibrary methods */
+    d3d12_pipeline_library_StorePipeline,
+    d3d12_pipeline_library_LoadGraphicsPipeline,
+    d3d12_pipeline_library_LoadComputePipeline,
+    d3d12_pipeline_library_GetSerializedSize,
+    d3d12_pipeline_library_Serialize,
+    /* ID3D12PipelineLibrary1 methods */
+    d3d12_pipeline_library_LoadPipeline,
+};
+
+static HRESULT d3d12_pipeline_library_load(struct d3d12_pipeline_library *library,
+        const void *blob, size_t blob_size)
+{
+    const struct vkd3d_pipeline_cache_header *header = blob;
+    uint32_t count, vk_bind_point, name_size, i;
+    const uint8_t *ptr, *end;
+    uint64_t desc_hash;
+    char *name;
+    HRESULT hr;
+
+    if (FAILED(hr = d3d12_device_validate_pipeline_cache_header(library->device,
+            header, VKD3D_PIPELINE_LIBRARY_MAGIC, blob_size)))
+        return hr;
+
+    ptr = (const uint8_t *)(header + 1);
+    end = (const uint8_t *)blob + blob_size;
+    if (align(header->data_size, sizeof(uint32_t)) + sizeof(count) > end - ptr)
+        return E_INVALIDARG;
+    ptr += align(header->data_size, sizeof(uint32_t));
+
+    memcpy(&count, ptr, sizeof(count));
+    ptr += sizeof(count);
+    for (i = 0; i < count; ++i)
+    {
+        if (end - ptr < 2 * sizeof(uint32_t) + sizeof(uint64_t))
+            return E_INVALIDARG;
+        memcpy(&vk_bind_point, ptr, sizeof(vk_bind_point));
+        ptr += sizeof(vk_bind_point);
+        memcpy(&desc_hash, ptr, sizeof(desc_hash));
+        ptr += sizeof(desc_hash);
+        memcpy(&name_size, ptr, sizeof(name_size));
+        ptr += sizeof(name_size);
+
+        if (!name_size || align(name_size, sizeof(uint32_t)) > end - ptr || ptr[name_size - 1])
+            return E_INVALIDARG;
+        if (!(name = vkd3d_strdup((const char *)ptr)))
+            return E_OUTOFMEMORY;
+        ptr += align(name_size, sizeof(uint32_t));
+
+        if (FAILED(hr = d3d12_pipeline_library_add_entry(library, name, vk_bind_point, desc_hash)))
+        {
+            vkd3d_free(name);
+            return hr;
+        }
+    }
+
+    /* Failing to reuse the Vulkan pipelines is not fatal. */
+    if (FAILED(hr = d3d12_device_merge_pipeline_cache(library->device, header + 1, header->data_size)))
+        WARN("Failed to merge pipeline cache data, hr %#x.\n", hr);
+
+    TRACE("Loaded %u pipelines and %u bytes of pipeline cache data.\n", count, header->data_size);
+
+    return S_OK;
+}
+
+HRESULT d3d12_pipeline_library_create(struct d3d12_device *device, const void *blob,
+        size_t blob_size, struct d3d12_pipeline_library **library)
+{
+    struct d3d12_pipeline_library *object;
+    HRESULT hr;
+
+    if (!(object = vkd3d_calloc(1, sizeof(*object))))
+        return E_OUTOFMEMORY;
+
+    object->ID3D12PipelineLibrary1_iface.lpVtbl = &d3d12_pipeline_library_vtbl;
+    object->refcount = 1;
+    object->device = device;
+    vkd3d_mutex_init(&object->mutex);
+
+    if (blob_size && FAILED(hr = d3d12_pipeline_library_load(object, blob, blob_size)))
+    {
+        d3d12_pipeline_library_cleanup(object);
+        vkd3d_free(object);
+        return hr;
+    }
+
+    if (FAILED(hr = vkd3d_private_store_init(&object->private_store)))
+    {
+        d3d12_pipeline_library_cleanup(object);
+        vkd3d_free(object);
+        return hr;
+    }
+
+    d3d12_device_add_ref(device);
+
+    TRACE("Created pipeline library %p.\n", object);
+
+    *library = object;
+
+    return S_OK;
+}
+
 static enum VkPrimitiveTopology vk_topology_from_d3d12_topology(D3D12_PRIMITIVE_TOPOLOGY topology)
 {
     switch (topology)
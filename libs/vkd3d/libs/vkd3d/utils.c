@@ -19,6 +19,9 @@
 #include "vkd3d_private.h"
 
 #include <errno.h>
+#ifndef _WIN32
+# include <unistd.h>
+#endif
 
 #define COLOR         (VK_IMAGE_ASPECT_COLOR_BIT)
 #define DEPTH         (VK_IMAGE_ASPECT_DEPTH_BIT)
@@ -877,6 +880,28 @@ bool vkd3d_get_program_name(char program_name[PATH_MAX])
     return true;
 }
 
+#elif defined(_WIN32)
+
+bool vkd3d_get_program_name(char program_name[PATH_MAX])
+{
+    char buffer[MAX_PATH];
+    const char *name;
+    DWORD len;
+
+    *program_name = '\0';
+    if (!(len = GetModuleFileNameA(NULL, buffer, ARRAY_SIZE(buffer))) || len == ARRAY_SIZE(buffer))
+        return false;
+
+    if ((name = strrchr(buffer, '\\')))
+        ++name;
+    else
+        name = buffer;
+
+    strncpy(program_name, name, PATH_MAX);
+    program_name[PATH_MAX - 1] = '\0';
+    return true;
+}
+
 #else
 
 bool vkd3d_get_program_name(char program_name[PATH_MAX])
@@ -887,6 +912,24 @@ bool vkd3d_get_program_name(char program_name[PATH_MAX])
 
 #endif  /* HAVE_DECL_PROGRAM_INVOCATION_NAME */
 
+unsigned int vkd3d_get_cpu_count(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return max(info.dwNumberOfProcessors, 1);
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long count;
+
+    if ((count = sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+        return 1;
+    return count;
+#else
+    return 1;
+#endif
+}
+
 static struct vkd3d_private_data *vkd3d_private_store_get_private_data(
         const struct vkd3d_private_store *store, const GUID *tag)
 {
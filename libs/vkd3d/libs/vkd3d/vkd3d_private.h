@@ -1287,6 +1287,7 @@ struct d3d12_pipeline_state
         struct d3d12_compute_pipeline_state compute;
     } u;
     VkPipelineBindPoint vk_bind_point;
+    uint64_t desc_hash;
 
     struct d3d12_pipeline_uav_counter_state uav_counters;
 
@@ -1353,6 +1354,32 @@ VkPipeline d3d12_pipeline_state_get_or_create_pipeline(struct d3d12_pipeline_sta
         D3D12_PRIMITIVE_TOPOLOGY topology, const uint32_t *strides, VkFormat dsv_format, VkRenderPass *vk_render_pass);
 struct d3d12_pipeline_state *unsafe_impl_from_ID3D12PipelineState(ID3D12PipelineState *iface);
 
+struct d3d12_pipeline_library_entry
+{
+    char *name;
+    VkPipelineBindPoint vk_bind_point;
+    uint64_t desc_hash;
+};
+
+/* ID3D12PipelineLibrary */
+struct d3d12_pipeline_library
+{
+    ID3D12PipelineLibrary1 ID3D12PipelineLibrary1_iface;
+    LONG refcount;
+
+    struct vkd3d_mutex mutex;
+    struct d3d12_pipeline_library_entry *entries;
+    size_t entries_size;
+    size_t entry_count;
+
+    struct d3d12_device *device;
+
+    struct vkd3d_private_store private_store;
+};
+
+HRESULT d3d12_pipeline_library_create(struct d3d12_device *device, const void *blob,
+        size_t blob_size, struct d3d12_pipeline_library **library);
+
 struct vkd3d_buffer
 {
     VkBuffer vk_buffer;
@@ -1727,6 +1754,36 @@ struct vkd3d_uav_clear_state
 HRESULT vkd3d_uav_clear_state_init(struct vkd3d_uav_clear_state *state, struct d3d12_device *device);
 void vkd3d_uav_clear_state_cleanup(struct vkd3d_uav_clear_state *state, struct d3d12_device *device);
 
+#define VKD3D_MAX_SHADER_COMPILE_THREADS 4
+
+struct vkd3d_shader_compile_task
+{
+    struct list entry;
+    void (*execute)(struct vkd3d_shader_compile_task *task);
+    unsigned int *pending;
+};
+
+/* Worker threads translating shaders for concurrent pipeline state creation.
+ * Waiters execute queued tasks themselves, so a pool without threads still
+ * makes progress. */
+struct vkd3d_shader_compile_pool
+{
+    union vkd3d_thread_handle threads[VKD3D_MAX_SHADER_COMPILE_THREADS];
+    unsigned int thread_count;
+
+    struct vkd3d_mutex mutex;
+    struct vkd3d_cond cond;
+    struct vkd3d_cond done_cond;
+    struct list tasks;
+    bool should_exit;
+};
+
+HRESULT vkd3d_shader_compile_pool_init(struct vkd3d_shader_compile_pool *pool, struct d3d12_device *device);
+void vkd3d_shader_compile_pool_cleanup(struct vkd3d_shader_compile_pool *pool, struct d3d12_device *device);
+void vkd3d_shader_compile_pool_submit(struct vkd3d_shader_compile_pool *pool,
+        struct vkd3d_shader_compile_task *task, unsigned int *pending);
+void vkd3d_shader_compile_pool_wait(struct vkd3d_shader_compile_pool *pool, unsigned int *pending);
+
 struct desc_object_cache_head
 {
     void *head;
@@ -1743,6 +1800,23 @@ struct vkd3d_desc_object_cache
 
 #define VKD3D_DESCRIPTOR_POOL_COUNT 6
 
+#define VKD3D_PIPELINE_CACHE_MAGIC   VKD3D_MAKE_TAG('V', 'K', 'P', 'C')
+#define VKD3D_PIPELINE_LIBRARY_MAGIC VKD3D_MAKE_TAG('V', 'K', 'L', '2')
+#define VKD3D_PIPELINE_CACHE_VERSION 1
+
+/* Prefixes both the on-disk pipeline cache and serialised pipeline
+ * libraries; Vulkan pipeline cache data follows the header. */
+struct vkd3d_pipeline_cache_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint32_t driver_version;
+    uint32_t data_size;
+    uint8_t uuid[VK_UUID_SIZE];
+};
+
 /* ID3D12Device */
 struct d3d12_device
 {
@@ -1762,6 +1836,8 @@ struct d3d12_device
     struct vkd3d_desc_object_cache cbuffer_desc_cache;
     struct vkd3d_render_pass_cache render_pass_cache;
     VkPipelineCache vk_pipeline_cache;
+    char *pipeline_cache_path;
+    size_t pipeline_cache_size;
 
     VkPhysicalDeviceMemoryProperties memory_properties;
 
@@ -1799,6 +1875,7 @@ struct d3d12_device
     const struct vkd3d_format_compatibility_list *format_compatibility_lists;
     struct vkd3d_null_resources null_resources;
     struct vkd3d_uav_clear_state uav_clear_state;
+    struct vkd3d_shader_compile_pool shader_compile_pool;
 
     VkDescriptorPoolSize vk_pool_sizes[VKD3D_DESCRIPTOR_POOL_COUNT];
     unsigned int vk_pool_count;
@@ -1808,6 +1885,12 @@ struct d3d12_device
 
 HRESULT d3d12_device_create(struct vkd3d_instance *instance,
         const struct vkd3d_device_create_info *create_info, struct d3d12_device **device);
+void d3d12_device_get_pipeline_cache_header(struct d3d12_device *device,
+        struct vkd3d_pipeline_cache_header *header, uint32_t magic, size_t data_size);
+HRESULT d3d12_device_get_pipeline_cache_data(struct d3d12_device *device, void *data, size_t *size);
+HRESULT d3d12_device_merge_pipeline_cache(struct d3d12_device *device, const void *data, size_t size);
+HRESULT d3d12_device_validate_pipeline_cache_header(struct d3d12_device *device,
+        const struct vkd3d_pipeline_cache_header *header, uint32_t magic, size_t size);
 struct vkd3d_queue *d3d12_device_get_vkd3d_queue(struct d3d12_device *device, D3D12_COMMAND_LIST_TYPE type);
 bool d3d12_device_is_uma(struct d3d12_device *device, bool *coherent);
 void d3d12_device_mark_as_removed(struct d3d12_device *device, HRESULT reason,
@@ -1963,6 +2046,7 @@ HRESULT vkd3d_load_vk_device_procs(struct vkd3d_vk_device_procs *procs,
 extern const char vkd3d_build[];
 
 bool vkd3d_get_program_name(char program_name[PATH_MAX]);
+unsigned int vkd3d_get_cpu_count(void);
 
 VkResult vkd3d_set_vk_object_name_utf8(struct d3d12_device *device, uint64_t vk_object,
         VkDebugReportObjectTypeEXT vk_object_type, const char *name);
@@ -0,0 +1,193 @@
+/*
+ * Process spawn latency benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <windef.h>
+#include <winbase.h>
+
+#include "wine/debug.h"
+
+struct job
+{
+    HANDLE        process;
+    LARGE_INTEGER start;
+};
+
+static LARGE_INTEGER frequency;
+
+static void usage(void)
+{
+    printf( "Usage: spawnbench [/n count] [/j jobs] [command line]\n\n"
+            "Spawns the command count times (default 100), with up to jobs processes\n"
+            "running at the same time (default 1), and reports the spawn-to-exit latency.\n"
+            "Without a command, spawnbench starts itself with an empty child payload.\n\n"
+            "Set WINE_STARTUP_TIMELINE=1 to get the per-phase startup timeline of each child.\n" );
+}
+
+static WCHAR *build_command_line( int argc, WCHAR *argv[] )
+{
+    static const WCHAR child_arg[] = L" /child";
+    WCHAR *cmdline, *p;
+    size_t len = 0;
+    int i;
+
+    if (!argc)
+    {
+        WCHAR path[MAX_PATH];
+
+        GetModuleFileNameW( NULL, path, ARRAY_SIZE(path) );
+        if (!(cmdline = malloc( (wcslen( path ) + 2 + wcslen( child_arg ) + 1) * sizeof(WCHAR) ))) return NULL;
+        swprintf( cmdline, wcslen( path ) + 2 + wcslen( child_arg ) + 1, L"\"%s\"%s", path, child_arg );
+        return cmdline;
+    }
+
+    for (i = 0; i < argc; i++) len += wcslen( argv[i] ) + 3;
+    if (!(p = cmdline = malloc( len * sizeof(WCHAR) ))) return NULL;
+    for (i = 0; i < argc; i++)
+    {
+        BOOL quote = !argv[i][0] || wcspbrk( argv[i], L" \t" );
+
+        if (i) *p++ = ' ';
+        if (quote) *p++ = '"';
+        wcscpy( p, argv[i] );
+        p += wcslen( p );
+        if (quote) *p++ = '"';
+    }
+    *p = 0;
+    return cmdline;
+}
+
+static BOOL start_job( const WCHAR *cmdline, struct job *job )
+{
+    STARTUPINFOW si = { sizeof(si) };
+    PROCESS_INFORMATION pi;
+    WCHAR *buffer;
+    BOOL ret;
+
+    /* CreateProcessW may modify the command line */
+    if (!(buffer = wcsdup( cmdline ))) return FALSE;
+    QueryPerformanceCounter( &job->start );
+    ret = CreateProcessW( NULL, buffer, NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi );
+    free( buffer );
+    if (!ret)
+    {
+        fprintf( stderr, "spawnbench: failed to start %s, error %lu\n", debugstr_w(cmdline), GetLastError() );
+        return FALSE;
+    }
+    CloseHandle( pi.hThread );
+    job->process = pi.hProcess;
+    return TRUE;
+}
+
+static double elapsed_ms( const LARGE_INTEGER *start, const LARGE_INTEGER *end )
+{
+    return (end->QuadPart - start->QuadPart) * 1000.0 / frequency.QuadPart;
+}
+
+static int __cdecl compare_double( const void *a, const void *b )
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+static int run_benchmark( const WCHAR *cmdline, unsigned int count, unsigned int jobs )
+{
+    HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+    struct job running[MAXIMUM_WAIT_OBJECTS];
+    unsigned int started = 0, done = 0, active = 0, i;
+    LARGE_INTEGER start, end;
+    double *latency, total = 0.0, wall;
+
+    if (!(latency = malloc( count * sizeof(*latency) ))) return 1;
+
+    QueryPerformanceCounter( &start );
+    while (done < count)
+    {
+        DWORD ret;
+
+        while (active < jobs && started < count)
+        {
+            if (!start_job( cmdline, &running[active] ))
+            {
+                free( latency );
+                return 1;
+            }
+            handles[active] = running[active].process;
+            active++;
+            started++;
+        }
+
+        ret = WaitForMultipleObjects( active, handles, FALSE, INFINITE );
+        if (ret >= WAIT_OBJECT_0 + active)
+        {
+            fprintf( stderr, "spawnbench: wait failed, error %lu\n", GetLastError() );
+            free( latency );
+            return 1;
+        }
+        i = ret - WAIT_OBJECT_0;
+        QueryPerformanceCounter( &end );
+        latency[done] = elapsed_ms( &running[i].start, &end );
+        total += latency[done++];
+        CloseHandle( running[i].process );
+        running[i] = running[--active];
+        handles[i] = handles[active];
+    }
+    QueryPerformanceCounter( &end );
+    wall = elapsed_ms( &start, &end );
+
+    qsort( latency, count, sizeof(*latency), compare_double );
+    printf( "%u processes, %u jobs, %.1f ms total, %.1f processes/s\n", count, jobs, wall, count * 1000.0 / wall );
+    printf( "latency ms: min %.3f median %.3f avg %.3f p95 %.3f max %.3f\n",
+            latency[0], latency[count / 2], total / count, latency[min( count - 1, count * 95 / 100 )],
+            latency[count - 1] );
+    free( latency );
+    return 0;
+}
+
+int __cdecl wmain( int argc, WCHAR *argv[] )
+{
+    unsigned int count = 100, jobs = 1;
+    WCHAR *cmdline;
+    int i, ret;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (argv[i][0] != '/' && argv[i][0] != '-') break;
+        if (!wcsicmp( argv[i] + 1, L"child" )) return 0;
+        if (!wcsicmp( argv[i] + 1, L"n" ) && i + 1 < argc) count = wcstoul( argv[++i], NULL, 10 );
+        else if (!wcsicmp( argv[i] + 1, L"j" ) && i + 1 < argc) jobs = wcstoul( argv[++i], NULL, 10 );
+        else
+        {
+            usage();
+            return !wcscmp( argv[i] + 1, L"?" ) ? 0 : 1;
+        }
+    }
+    if (!count || !jobs)
+    {
+        usage();
+        return 1;
+    }
+    jobs = min( jobs, MAXIMUM_WAIT_OBJECTS );
+
+    if (!(cmdline = build_command_line( argc - i, argv + i ))) return 1;
+    QueryPerformanceFrequency( &frequency );
+    ret = run_benchmark( cmdline, count, jobs );
+    free( cmdline );
+    return ret;
+}
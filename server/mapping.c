@@ -130,6 +130,52 @@ static const struct object_ops shared_map_ops =
 
 static struct list shared_map_list = LIST_INIT( shared_map_list );
 
+/* file caching the relocated contents of a PE image mapping */
+struct reloc_map
+{
+    struct object   obj;             /* object header */
+    struct fd      *fd;              /* file descriptor of the mapped PE file */
+    struct file    *file;            /* temp file holding the relocated image */
+    client_ptr_t    addr;            /* address the image is relocated to */
+    file_pos_t      size;            /* size of the PE file when the cache was created */
+    time_t          mtime;           /* modification time of the PE file when the cache was created */
+    unsigned int    checksum;        /* image header checksum */
+    process_id_t    filler;          /* process currently filling the cache */
+    int             ready;           /* cache contents are valid */
+    struct list     entry;           /* entry in global reloc maps list */
+};
+
+static void reloc_map_dump( struct object *obj, int verbose );
+static void reloc_map_destroy( struct object *obj );
+
+static const struct object_ops reloc_map_ops =
+{
+    sizeof(struct reloc_map),  /* size */
+    &no_type,                  /* type */
+    reloc_map_dump,            /* dump */
+    no_add_queue,              /* add_queue */
+    NULL,                      /* remove_queue */
+    NULL,                      /* signaled */
+    NULL,                      /* get_esync_fd */
+    NULL,                      /* get_fsync_idx */
+    NULL,                      /* satisfied */
+    no_signal,                 /* signal */
+    no_get_fd,                 /* get_fd */
+    default_map_access,        /* map_access */
+    default_get_sd,            /* get_sd */
+    default_set_sd,            /* set_sd */
+    no_get_full_name,          /* get_full_name */
+    no_lookup_name,            /* lookup_name */
+    no_link_name,              /* link_name */
+    NULL,                      /* unlink_name */
+    no_open_file,              /* open_file */
+    no_kernel_obj_list,        /* get_kernel_obj_list */
+    no_close_handle,           /* close_handle */
+    reloc_map_destroy          /* destroy */
+};
+
+static struct list reloc_map_list = LIST_INIT( reloc_map_list );
+
 /* memory view mapped in client address space */
 struct memory_view
 {
@@ -137,6 +183,7 @@ struct memory_view
     struct fd      *fd;              /* fd for mapped file */
     struct ranges  *committed;       /* list of committed ranges in this mapping */
     struct shared_map *shared;       /* temp file for shared PE mapping */
+    struct reloc_map *reloc;         /* temp file for relocated PE image */
     pe_image_info_t image;           /* image info (for PE image mapping) */
     unsigned int    flags;           /* SEC_* flags */
     client_ptr_t    base;            /* view base address (in process addr space) */
@@ -171,6 +218,7 @@ struct mapping
     pe_image_info_t image;           /* image info (for PE image mapping) */
     struct ranges  *committed;       /* list of committed ranges in this mapping */
     struct shared_map *shared;       /* temp file for shared PE mapping */
+    struct reloc_map *reloc;         /* temp file for relocated PE image */
     void           *shared_ptr;      /* mmaped pointer for shared mappings */
 };
 
@@ -275,6 +323,23 @@ static void shared_map_destroy( struct object *obj )
     list_remove( &shared->entry );
 }
 
+static void reloc_map_dump( struct object *obj, int verbose )
+{
+    struct reloc_map *reloc = (struct reloc_map *)obj;
+    fprintf( stderr, "Relocated mapping fd=%p file=%p addr=%08x%08x ready=%d\n",
+             reloc->fd, reloc->file, (unsigned int)(reloc->addr >> 32), (unsigned int)reloc->addr,
+             reloc->ready );
+}
+
+static void reloc_map_destroy( struct object *obj )
+{
+    struct reloc_map *reloc = (struct reloc_map *)obj;
+
+    release_object( reloc->fd );
+    release_object( reloc->file );
+    list_remove( &reloc->entry );
+}
+
 /* extend a file beyond the current end of file */
 int grow_file( int unix_fd, file_pos_t new_size )
 {
@@ -482,6 +547,7 @@ static void free_memory_view( struct memory_view *view )
     if (view->fd) release_object( view->fd );
     if (view->committed) release_object( view->committed );
     if (view->shared) release_object( view->shared );
+    if (view->reloc) release_object( view->reloc );
     list_remove( &view->entry );
     free( view );
 }
@@ -506,6 +572,54 @@ static struct shared_map *get_shared_file( struct fd *fd )
     return NULL;
 }
 
+/* find or create the relocated image cache for a given mapping */
+static struct reloc_map *get_reloc_file( struct mapping *mapping, client_ptr_t addr )
+{
+    struct reloc_map *reloc, *next;
+    struct file *file;
+    struct stat st;
+    int unix_fd;
+
+    if ((unix_fd = get_unix_fd( mapping->fd )) == -1) return NULL;
+    if (fstat( unix_fd, &st ) == -1)
+    {
+        file_set_error();
+        return NULL;
+    }
+
+    LIST_FOR_EACH_ENTRY_SAFE( reloc, next, &reloc_map_list, struct reloc_map, entry )
+    {
+        if (!is_same_file_fd( reloc->fd, mapping->fd )) continue;
+        if (reloc->size != st.st_size || reloc->mtime != st.st_mtime ||
+            reloc->checksum != mapping->image.checksum)
+        {
+            /* the file has been modified in place, views already using the cache keep it */
+            list_remove( &reloc->entry );
+            list_init( &reloc->entry );
+            continue;
+        }
+        if (reloc->addr == addr) return (struct reloc_map *)grab_object( reloc );
+    }
+
+    if ((unix_fd = create_temp_file( mapping->image.map_size )) == -1) return NULL;
+    if (!(file = create_file_for_fd( unix_fd, FILE_GENERIC_READ|FILE_GENERIC_WRITE, 0 ))) return NULL;
+    if (!(reloc = alloc_object( &reloc_map_ops )))
+    {
+        release_object( file );
+        return NULL;
+    }
+    reloc->fd       = (struct fd *)grab_object( mapping->fd );
+    reloc->file     = file;
+    reloc->addr     = addr;
+    reloc->size     = st.st_size;
+    reloc->mtime    = st.st_mtime;
+    reloc->checksum = mapping->image.checksum;
+    reloc->filler   = 0;
+    reloc->ready    = 0;
+    list_add_head( &reloc_map_list, &reloc->entry );
+    return reloc;
+}
+
 /* return the size of the memory mapping and file range of a given section */
 static inline void get_section_sizes( const IMAGE_SECTION_HEADER *sec, size_t *map_size,
                                       off_t *file_start, size_t *file_size )
@@ -979,6 +1093,7 @@ static struct mapping *create_mapping( struct object *root, const struct unicode
     mapping->size        = size;
     mapping->fd          = NULL;
     mapping->shared      = NULL;
+    mapping->reloc       = NULL;
     mapping->committed   = NULL;
     mapping->shared_ptr  = MAP_FAILED;
 
@@ -1189,6 +1304,7 @@ static void mapping_destroy( struct object *obj )
     if (mapping->fd) release_object( mapping->fd );
     if (mapping->committed) release_object( mapping->committed );
     if (mapping->shared) release_object( mapping->shared );
+    if (mapping->reloc) release_object( mapping->reloc );
     if (mapping->shared_ptr != MAP_FAILED) munmap( mapping->shared_ptr, mapping->size );
 }
 
@@ -1404,6 +1520,74 @@ DECL_HANDLER(get_image_map_address)
     release_object( mapping );
 }
 
+/* get the relocated image cache for an image mapping */
+DECL_HANDLER(get_image_reloc_cache)
+{
+    struct mapping *mapping;
+    struct reloc_map *reloc;
+    struct process *process;
+
+    if (!(mapping = get_mapping_obj( current->process, req->handle, SECTION_MAP_READ ))) return;
+
+    if (!(mapping->flags & SEC_IMAGE) || !mapping->fd || is_fd_removable( mapping->fd ) ||
+        !req->addr || req->addr == mapping->image.base || req->addr != mapping->image.map_addr)
+    {
+        set_error( STATUS_INVALID_PARAMETER );
+        goto done;
+    }
+
+    if (!mapping->reloc && !(mapping->reloc = get_reloc_file( mapping, req->addr ))) goto done;
+    reloc = mapping->reloc;
+
+    if (!reloc->ready && reloc->filler)
+    {
+        /* reclaim the cache if the process filling it went away */
+        if (!(process = get_process_from_id( reloc->filler ))) reloc->filler = 0;
+        else release_object( process );
+        clear_error();
+    }
+
+    if (reloc->ready)
+    {
+        reply->file  = alloc_handle( current->process, reloc->file, GENERIC_READ, 0 );
+        reply->ready = 1;
+    }
+    else if (!reloc->filler)
+    {
+        /* The filling process gets a writable file even though the mapping handle only needs
+         * SECTION_MAP_READ. Like the shared sections of the image, the contents are then trusted
+         * by every process mapping the image, so only hand it out to a process that is allowed
+         * to map the image for execution itself; others simply map the image uncached. */
+        if (!(get_handle_access( current->process, req->handle ) & SECTION_MAP_EXECUTE))
+        {
+            set_error( STATUS_ACCESS_DENIED );
+            goto done;
+        }
+        if ((reply->file = alloc_handle( current->process, reloc->file, GENERIC_READ|GENERIC_WRITE, 0 )))
+            reloc->filler = current->process->id;
+    }
+
+done:
+    release_object( mapping );
+}
+
+/* release the relocated image cache after trying to fill it */
+DECL_HANDLER(set_image_reloc_cache)
+{
+    struct mapping *mapping;
+
+    if (!(mapping = get_mapping_obj( current->process, req->handle, SECTION_MAP_READ ))) return;
+
+    if (!mapping->reloc || mapping->reloc->filler != current->process->id)
+        set_error( STATUS_INVALID_PARAMETER );
+    else
+    {
+        mapping->reloc->ready  = req->ready;
+        mapping->reloc->filler = 0;
+    }
+    release_object( mapping );
+}
+
 /* add a memory view in the current process */
 DECL_HANDLER(map_view)
 {
@@ -1437,6 +1621,7 @@ DECL_HANDLER(map_view)
         view->fd        = !is_fd_removable( mapping->fd ) ? (struct fd *)grab_object( mapping->fd ) : NULL;
         view->committed = mapping->committed ? (struct ranges *)grab_object( mapping->committed ) : NULL;
         view->shared    = NULL;
+        view->reloc     = NULL;
         add_process_view( current, view );
     }
 
@@ -1474,6 +1659,7 @@ DECL_HANDLER(map_image_view)
         view->fd        = !is_fd_removable( mapping->fd ) ? (struct fd *)grab_object( mapping->fd ) : NULL;
         view->committed = NULL;
         view->shared    = mapping->shared ? (struct shared_map *)grab_object( mapping->shared ) : NULL;
+        view->reloc     = mapping->reloc ? (struct reloc_map *)grab_object( mapping->reloc ) : NULL;
         view->image     = mapping->image;
         view->image.machine     = req->machine;
         view->image.entry_point = req->entry;
@@ -73,6 +73,8 @@ struct desktop
     unsigned int         last_press_alt:1; /* last key press was Alt (used to determine msg on Alt release) */
     struct object       *shared_mapping;   /* desktop shared memory mapping */
     const desktop_shm_t *shared;           /* desktop shared memory */
+    struct object       *windows_mapping;  /* desktop windows shared memory mapping */
+    const window_shm_t  *windows_shared;   /* desktop windows shared memory, indexed by user handle */
 };
 
 /* user handles functions */
@@ -251,6 +253,28 @@ static inline int intersect_rect( rectangle_t *dst, const rectangle_t *src1, con
     return !is_rect_empty( dst );
 }
 
+/* shared memory helpers, see SHARED_READ_BEGIN in win32u for the reader side */
+
+#if defined(__i386__) || defined(__x86_64__)
+#define __SHARED_INCREMENT_SEQ( x ) ++(x)
+#else
+#define __SHARED_INCREMENT_SEQ( x ) __atomic_add_fetch( &(x), 1, __ATOMIC_RELEASE )
+#endif
+
+#define SHARED_WRITE_BEGIN( object, type )                           \
+    do {                                                             \
+        const type *__shared = (object)->shared;                     \
+        type *shared = (type *)__shared;                             \
+        unsigned int __seq = __SHARED_INCREMENT_SEQ( shared->seq );  \
+        assert( (__seq & 1) != 0 );                                  \
+        do
+
+#define SHARED_WRITE_END                                             \
+        while(0);                                                    \
+        __seq = __SHARED_INCREMENT_SEQ( shared->seq ) - __seq;       \
+        assert( __seq == 1 );                                        \
+    } while(0);
+
 /* validate a window handle and return the full handle */
 static inline user_handle_t get_valid_window_handle( user_handle_t win )
 {
@@ -30,6 +30,7 @@
 #include "ntuser.h"
 
 #include "object.h"
+#include "file.h"
 #include "request.h"
 #include "thread.h"
 #include "process.h"
@@ -94,6 +95,7 @@ struct window
     struct property *properties;      /* window properties array */
     int              nb_extra_bytes;  /* number of extra bytes */
     char            *extra_bytes;     /* extra bytes storage */
+    const window_shm_t *shared;       /* window shared memory */
 };
 
 static void window_dump( struct object *obj, int verbose );
@@ -189,6 +191,32 @@ static void window_destroy( struct object *obj )
     }
 }
 
+/* copy the window state that clients may query without a server call to the shared memory */
+static void update_window_shared( struct window *win )
+{
+    if (!win->shared) return;
+
+    SHARED_WRITE_BEGIN( win, window_shm_t )
+    {
+        shared->handle      = win->handle;
+        shared->parent      = win->parent ? win->parent->handle : 0;
+        shared->owner       = win->owner;
+        shared->pid         = win->thread ? get_process_id( win->thread->process ) : 0;
+        shared->tid         = win->thread ? get_thread_id( win->thread ) : 0;
+        shared->style       = win->style;
+        shared->ex_style    = win->ex_style;
+        shared->is_unicode  = win->is_unicode;
+        shared->dpi         = win->dpi;
+        shared->awareness   = win->dpi_awareness;
+        shared->id          = win->id;
+        shared->instance    = win->instance;
+        shared->user_data   = win->user_data;
+        shared->window_rect = win->window_rect;
+        shared->client_rect = win->client_rect;
+    }
+    SHARED_WRITE_END
+}
+
 /* retrieve a pointer to a window from its handle */
 static inline struct window *get_window( user_handle_t handle )
 {
@@ -348,6 +376,8 @@ static int set_parent_window( struct window *win, struct window *parent )
 
         if (win->paint_flags & (PAINT_HAS_PIXEL_FORMAT | PAINT_PIXEL_FORMAT_CHILD))
             update_pixel_format_flags( win );
+
+        update_window_shared( win );
     }
     else  /* move it to parent unlinked list */
     {
@@ -490,10 +520,22 @@ static void detach_window_thread( struct window *win )
     release_class( win->class );
     win->class = NULL;
 
+    /* the shared entry lives in the desktop mapping, so clear it */
+    /* before the desktop can go away */
+    if (win->shared)
+    {
+        SHARED_WRITE_BEGIN( win, window_shm_t )
+        {
+            shared->handle = 0;
+        }
+        SHARED_WRITE_END
+        win->shared = NULL;
+    }
+
     /* don't hold a reference to the desktop so that the desktop window can be */
     /* destroyed when the desktop ref count reaches zero */
-    release_object( win->desktop );
     win->thread = NULL;
+    release_object( win->desktop );
 }
 
 /* get the process owning the top window of a given desktop */
@@ -587,6 +629,7 @@ static struct window *create_window( struct window *parent, struct window *owner
     win->nb_extra_bytes = 0;
     win->extra_bytes    = NULL;
     win->window_rect = win->visible_rect = win->surface_rect = win->client_rect = empty_rect;
+    win->shared         = NULL;
     list_init( &win->children );
     list_init( &win->unlinked );
 
@@ -597,6 +640,7 @@ static struct window *create_window( struct window *parent, struct window *owner
         win->nb_extra_bytes = extra_bytes;
     }
     if (!(win->handle = alloc_user_handle( win, USER_WINDOW ))) goto failed;
+    win->shared = desktop->windows_shared + WINDOW_SHM_INDEX( win->handle );
 
     /* if parent belongs to a different thread and the window isn't */
     /* top-level, attach the two threads */
@@ -628,6 +672,7 @@ static struct window *create_window( struct window *parent, struct window *owner
     }
 
     current->desktop_users++;
+    update_window_shared( win );
     return win;
 
 failed:
@@ -1828,8 +1873,10 @@ static void set_window_pos( struct window *win, struct window *previous,
             offset_rect( &child->visible_rect, new_size - old_size, 0 );
             offset_rect( &child->surface_rect, new_size - old_size, 0 );
             offset_rect( &child->client_rect, new_size - old_size, 0 );
+            update_window_shared( child );
         }
     }
+    update_window_shared( win );
 
     /* reset cursor clip rectangle when the desktop changes size */
     if (win == win->desktop->top_window) set_clip_rectangle( win->desktop, NULL, SET_CURSOR_NOCLIP, 1 );
@@ -2101,6 +2148,7 @@ DECL_HANDLER(create_window)
     }
     win->style = req->style;
     win->ex_style = req->ex_style;
+    update_window_shared( win );
 
     reply->handle    = win->handle;
     reply->parent    = win->parent ? win->parent->handle : 0;
@@ -2164,6 +2212,7 @@ DECL_HANDLER(get_desktop_window)
         {
             detach_window_thread( desktop->top_window );
             desktop->top_window->style  = WS_POPUP | WS_VISIBLE | WS_CLIPSIBLINGS | WS_CLIPCHILDREN;
+            update_window_shared( desktop->top_window );
         }
     }
 
@@ -2176,6 +2225,7 @@ DECL_HANDLER(get_desktop_window)
         {
             detach_window_thread( desktop->msg_window );
             desktop->msg_window->style = WS_POPUP | WS_CLIPSIBLINGS | WS_CLIPCHILDREN;
+            update_window_shared( desktop->msg_window );
         }
     }
 
@@ -2211,6 +2261,7 @@ DECL_HANDLER(set_window_owner)
 
     reply->prev_owner = win->owner;
     reply->full_owner = win->owner = owner ? owner->handle : 0;
+    update_window_shared( win );
 }
 
 
@@ -2285,6 +2336,7 @@ DECL_HANDLER(set_window_info)
 
     /* changing window style triggers a non-client paint */
     if (req->flags & SET_WIN_STYLE) win->paint_flags |= PAINT_NONCLIENT;
+    if (req->flags) update_window_shared( win );
 }
 
 
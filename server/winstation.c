@@ -136,26 +136,6 @@ static const struct object_ops desktop_ops =
     desktop_destroy               /* destroy */
 };
 
-#if defined(__i386__) || defined(__x86_64__)
-#define __SHARED_INCREMENT_SEQ( x ) ++(x)
-#else
-#define __SHARED_INCREMENT_SEQ( x ) __atomic_add_fetch( &(x), 1, __ATOMIC_RELEASE )
-#endif
-
-#define SHARED_WRITE_BEGIN( object, type )                           \
-    do {                                                             \
-        const type *__shared = (object)->shared;                     \
-        type *shared = (type *)__shared;                             \
-        unsigned int __seq = __SHARED_INCREMENT_SEQ( shared->seq );  \
-        assert( (__seq & 1) != 0 );                                  \
-        do
-
-#define SHARED_WRITE_END                                             \
-        while(0);                                                    \
-        __seq = __SHARED_INCREMENT_SEQ( shared->seq ) - __seq;       \
-        assert( __seq == 1 );                                        \
-    } while(0);
-
 
 /* create a winstation object */
 static struct winstation *create_winstation( struct object *root, const struct unicode_str *name,
@@ -248,6 +228,8 @@ static int init_desktop_mapping( struct desktop *desktop, const struct unicode_s
 
     desktop->shared = NULL;
     desktop->shared_mapping = NULL;
+    desktop->windows_shared = NULL;
+    desktop->windows_mapping = NULL;
 
     if (!(dir = create_desktop_map_directory( desktop->winstation ))) return 0;
     if ((desktop->shared_mapping = create_shared_mapping( dir, name, sizeof(struct desktop_shared_memory),
@@ -257,8 +239,15 @@ static int init_desktop_mapping( struct desktop *desktop, const struct unicode_s
         ((desktop_shm_t *)desktop->shared)->update_serial = 1;
     }
     release_object( dir );
+    if (!desktop->shared) return 0;
+
+    /* the windows table is sparse, only the pages of used handles are ever touched */
+    if (!(dir = create_desktop_window_map_directory( desktop->winstation ))) return 0;
+    desktop->windows_mapping = create_shared_mapping( dir, name, WINDOW_SHM_ENTRIES * sizeof(struct window_shared_memory),
+                                                      0, NULL, (void **)&desktop->windows_shared );
+    release_object( dir );
 
-    return !!desktop->shared;
+    return !!desktop->windows_shared;
 }
 
 /* create a desktop object */
@@ -357,6 +346,8 @@ static void desktop_destroy( struct object *obj )
     list_remove( &desktop->entry );
     if (desktop->shared_mapping) release_object( desktop->shared_mapping );
     desktop->shared_mapping = NULL;
+    if (desktop->windows_mapping) release_object( desktop->windows_mapping );
+    desktop->windows_mapping = NULL;
     release_object( desktop->winstation );
 }
 
@@ -373,6 +364,7 @@ static void close_desktop_timeout( void *private )
     desktop->close_timeout = NULL;
     unlink_named_object( &desktop->obj );  /* make sure no other process can open it */
     unlink_named_object( desktop->shared_mapping );
+    unlink_named_object( desktop->windows_mapping );
     post_desktop_message( desktop, WM_CLOSE, 0, 0 );  /* and signal the owner to quit */
 }
 